@@ -657,6 +657,51 @@ TEST (active_transactions, restart_dropped)
 	}
 }
 
+// Replayed votes are dropped before signature checking, and copies of verified votes are not checked again
+TEST (active_transactions, vote_replay_filter)
+{
+	nano::system system;
+	nano::node_config node_config (nano::get_available_port (), system.logging);
+	node_config.online_weight_minimum = std::numeric_limits<nano::uint128_t>::max ();
+	node_config.frontiers_confirmation = nano::frontiers_confirmation_mode::disabled;
+	auto & node = *system.add_node (node_config);
+	nano::genesis genesis;
+	nano::keypair key;
+	auto send1 (std::make_shared<nano::state_block> (nano::test_genesis_key.pub, genesis.hash (), nano::test_genesis_key.pub, nano::genesis_amount - nano::Gxrb_ratio, key.pub, nano::test_genesis_key.prv, nano::test_genesis_key.pub, *system.work.generate (genesis.hash ())));
+	node.process_active (send1);
+	node.block_processor.flush ();
+	ASSERT_EQ (1, node.active.size ());
+	auto channel (std::make_shared<nano::transport::channel_udp> (node.network.udp_channels, node.network.endpoint (), node.network_params.protocol.protocol_version));
+	auto vote1 (std::make_shared<nano::vote> (nano::test_genesis_key.pub, nano::test_genesis_key.prv, 1, send1));
+	{
+		nano::lock_guard<std::mutex> guard (node.active.mutex);
+		ASSERT_FALSE (node.active.replay (*vote1));
+	}
+	node.vote_processor.vote (vote1, channel);
+	node.vote_processor.flush ();
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::vote, nano::stat::detail::vote_signature_checked));
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::vote, nano::stat::detail::vote_valid));
+	{
+		nano::lock_guard<std::mutex> guard (node.active.mutex);
+		ASSERT_TRUE (node.active.replay (*vote1));
+	}
+	node.vote_processor.vote (vote1, channel);
+	node.vote_processor.flush ();
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::vote, nano::stat::detail::vote_filtered_replay));
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::vote, nano::stat::detail::vote_signature_checked));
+	// Votes for blocks without an election are still processed, but their signature is only checked once
+	nano::keypair key2;
+	auto send2 (std::make_shared<nano::state_block> (nano::test_genesis_key.pub, send1->hash (), nano::test_genesis_key.pub, nano::genesis_amount - 2 * nano::Gxrb_ratio, key2.pub, nano::test_genesis_key.prv, nano::test_genesis_key.pub, 0));
+	auto vote2 (std::make_shared<nano::vote> (nano::test_genesis_key.pub, nano::test_genesis_key.prv, 2, std::vector<nano::block_hash>{ send2->hash () }));
+	node.vote_processor.vote (vote2, channel);
+	node.vote_processor.flush ();
+	node.vote_processor.vote (vote2, channel);
+	node.vote_processor.flush ();
+	ASSERT_EQ (2, node.stats.count (nano::stat::type::vote, nano::stat::detail::vote_indeterminate));
+	ASSERT_EQ (2, node.stats.count (nano::stat::type::vote, nano::stat::detail::vote_signature_checked));
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::vote, nano::stat::detail::vote_signature_known));
+}
+
 TEST (active_transactions, vote_replays)
 {
 	nano::system system;
@@ -703,3 +748,66 @@ TEST (active_transactions, vote_replays)
 	ASSERT_EQ (nano::vote_code::indeterminate, node.active.vote (vote1_send2));
 	ASSERT_EQ (nano::vote_code::indeterminate, node.active.vote (vote2_send2));
 }
+
+namespace nano
+{
+// Elections replaced or erased while a request_confirm pass has the mutex released are skipped, without touching their replacements
+TEST (active_transactions, request_confirm_replaced)
+{
+	nano::system system;
+	nano::node_config node_config (nano::get_available_port (), system.logging);
+	node_config.enable_voting = false;
+	node_config.frontiers_confirmation = nano::frontiers_confirmation_mode::disabled;
+	nano::node_flags node_flags;
+	// Passes are driven by the test
+	node_flags.disable_request_loop = true;
+	auto & node = *system.add_node (node_config, node_flags);
+	nano::keypair key;
+	// Enough elections for the pass to release the mutex at least once
+	size_t const count (2 * nano::active_transactions::request_confirm_batch_size);
+	for (size_t i (0); i < count; ++i)
+	{
+		nano::block_hash previous (i + 1);
+		auto block (std::make_shared<nano::state_block> (key.pub, previous, key.pub, 0, 0, key.prv, key.pub, *system.work.generate (previous)));
+		ASSERT_FALSE (node.active.start (block));
+	}
+	nano::unique_lock<std::mutex> lock (node.active.mutex);
+	ASSERT_EQ (count, node.active.roots.size ());
+	auto snapshot (node.active.sorted_roots ());
+	ASSERT_EQ (count, snapshot.size ());
+	// Pick elections the pass reaches only after releasing the mutex
+	auto & replaced (snapshot[count - 1]);
+	auto & erased (snapshot[count - 2]);
+	auto & finished (snapshot[count - 3]);
+	auto replaced_block (replaced.second->status.winner);
+	auto erased_block (erased.second->status.winner);
+	finished.second->stop ();
+	lock.unlock ();
+	node.active.erase (*replaced_block);
+	node.active.erase (*erased_block);
+	ASSERT_FALSE (node.active.start (replaced_block));
+	lock.lock ();
+	auto replacement (node.active.roots.find (replaced.first));
+	ASSERT_NE (node.active.roots.end (), replacement);
+	auto replacement_election (replacement->election);
+	ASSERT_NE (replaced.second, replacement_election);
+	// The stale snapshot still holds the old elections, which were stopped when erased
+	ASSERT_TRUE (replaced.second->stopped);
+	ASSERT_TRUE (erased.second->stopped);
+	node.active.request_confirm (lock, node.store.tx_begin_read (), snapshot);
+	// Unchanged elections are still visited, finished ones being erased
+	ASSERT_EQ (count - 2, node.active.roots.size ());
+	ASSERT_EQ (node.active.roots.end (), node.active.roots.find (finished.first));
+	ASSERT_EQ (node.active.roots.end (), node.active.roots.find (erased.first));
+	// The replacement is neither stopped through the stale entry nor erased in its place
+	replacement = node.active.roots.find (replaced.first);
+	ASSERT_NE (node.active.roots.end (), replacement);
+	ASSERT_EQ (replacement_election, replacement->election);
+	ASSERT_FALSE (replacement_election->stopped);
+	// The next pass visits the replacement
+	replacement_election->stop ();
+	node.active.request_confirm (lock, node.store.tx_begin_read (), node.active.sorted_roots ());
+	ASSERT_EQ (count - 3, node.active.roots.size ());
+	ASSERT_EQ (node.active.roots.end (), node.active.roots.find (replaced.first));
+}
+}
@@ -8,6 +8,8 @@
 
 #include <crypto/ed25519-donna/ed25519.h>
 
+#include <thread>
+
 TEST (ed25519, signing)
 {
 	nano::private_key prv (0);
@@ -217,6 +219,7 @@ TEST (receive_block, deserialize)
 	ASSERT_EQ (block1.hash (), block1.hash ());
 	block1.hashables.previous = 2;
 	block1.hashables.source = 4;
+	block1.refresh ();
 	std::vector<uint8_t> bytes;
 	{
 		nano::vectorstream stream1 (bytes);
@@ -367,25 +370,106 @@ TEST (state_block, hashing)
 	nano::state_block block (key.pub, 0, key.pub, 0, 0, key.prv, key.pub, 0);
 	auto hash (block.hash ());
 	block.hashables.account.bytes[0] ^= 0x1;
+	block.refresh ();
 	ASSERT_NE (hash, block.hash ());
 	block.hashables.account.bytes[0] ^= 0x1;
+	block.refresh ();
 	ASSERT_EQ (hash, block.hash ());
 	block.hashables.previous.bytes[0] ^= 0x1;
+	block.refresh ();
 	ASSERT_NE (hash, block.hash ());
 	block.hashables.previous.bytes[0] ^= 0x1;
+	block.refresh ();
 	ASSERT_EQ (hash, block.hash ());
 	block.hashables.representative.bytes[0] ^= 0x1;
+	block.refresh ();
 	ASSERT_NE (hash, block.hash ());
 	block.hashables.representative.bytes[0] ^= 0x1;
+	block.refresh ();
 	ASSERT_EQ (hash, block.hash ());
 	block.hashables.balance.bytes[0] ^= 0x1;
+	block.refresh ();
 	ASSERT_NE (hash, block.hash ());
 	block.hashables.balance.bytes[0] ^= 0x1;
+	block.refresh ();
 	ASSERT_EQ (hash, block.hash ());
 	block.hashables.link.bytes[0] ^= 0x1;
+	block.refresh ();
 	ASSERT_NE (hash, block.hash ());
 	block.hashables.link.bytes[0] ^= 0x1;
+	block.refresh ();
+	ASSERT_EQ (hash, block.hash ());
+}
+
+TEST (block, hash_cache)
+{
+	nano::keypair key;
+	nano::state_block block (key.pub, 0, key.pub, 0, 0, key.prv, key.pub, 0);
+	auto hash (block.hash ());
+	// Writing hashables directly keeps the cached hash until refreshed
+	block.hashables.balance = 1;
+	ASSERT_EQ (hash, block.hash ());
+	// Signature and work are not part of the hash, so they do not invalidate it
+	block.signature_set (nano::signature (1));
+	block.block_work_set (1);
 	ASSERT_EQ (hash, block.hash ());
+	block.refresh ();
+	auto hash2 (block.hash ());
+	ASSERT_NE (hash, hash2);
+	// Deserializing into an existing block discards the cached hash
+	nano::state_block block2 (key.pub, 0, key.pub, 0, 0, key.prv, key.pub, 0);
+	ASSERT_EQ (hash, block2.hash ());
+	std::vector<uint8_t> bytes;
+	{
+		nano::vectorstream stream (bytes);
+		block.serialize (stream);
+	}
+	nano::bufferstream stream (bytes.data (), bytes.size ());
+	ASSERT_FALSE (block2.deserialize (stream));
+	ASSERT_EQ (hash2, block2.hash ());
+	// Builders always hand out blocks with an up to date hash
+	nano::block_builder builder;
+	auto block3 = builder.state ()
+	              .from (block)
+	              .balance (2)
+	              .sign (key.prv, key.pub)
+	              .build ();
+	ASSERT_NE (hash2, block3->hash ());
+	block3->hashables.balance = 1;
+	block3->refresh ();
+	ASSERT_EQ (hash2, block3->hash ());
+}
+
+// Threads hashing the same block concurrently all see the same hash, and copies carry the cached hash
+TEST (block, hash_cache_concurrent)
+{
+	nano::keypair key;
+	nano::state_block block (key.pub, 0, key.pub, 0, 0, key.prv, key.pub, 0);
+	auto hash (block.hash ());
+	block.refresh ();
+	std::vector<nano::block_hash> hashes (4);
+	std::vector<std::thread> threads;
+	for (size_t i (0); i < hashes.size (); ++i)
+	{
+		threads.emplace_back ([&block, &hashes, i]() {
+			hashes[i] = block.hash ();
+		});
+	}
+	for (auto & thread : threads)
+	{
+		thread.join ();
+	}
+	for (auto const & hash_l : hashes)
+	{
+		ASSERT_EQ (hash, hash_l);
+	}
+	nano::state_block block2 (block);
+	block2.hashables.balance = 1;
+	ASSERT_EQ (hash, block2.hash ());
+	block2.refresh ();
+	ASSERT_NE (hash, block2.hash ());
+	block2 = block;
+	ASSERT_EQ (hash, block2.hash ());
 }
 
 TEST (block_uniquer, null)
@@ -431,6 +515,45 @@ TEST (block_uniquer, cleanup)
 	}
 }
 
+TEST (block_uniquer, serialized)
+{
+	nano::keypair key;
+	std::vector<std::shared_ptr<nano::block>> blocks;
+	blocks.push_back (std::make_shared<nano::send_block> (1, 2, 3, key.prv, key.pub, 4));
+	blocks.push_back (std::make_shared<nano::receive_block> (1, 2, key.prv, key.pub, 3));
+	blocks.push_back (std::make_shared<nano::open_block> (1, 2, 3, key.prv, key.pub, 4));
+	blocks.push_back (std::make_shared<nano::change_block> (1, 2, key.prv, key.pub, 3));
+	blocks.push_back (std::make_shared<nano::state_block> (1, 2, 3, 4, 5, key.prv, key.pub, 6));
+	nano::block_uniquer uniquer;
+	for (auto & block : blocks)
+	{
+		std::vector<uint8_t> bytes;
+		{
+			nano::vectorstream stream (bytes);
+			block->serialize (stream);
+		}
+		ASSERT_EQ (nano::block::size (block->type ()), bytes.size ());
+		nano::block_hash hash;
+		nano::block_hash full_hash;
+		nano::serialized_block_hashes (block->type (), bytes.data (), hash, full_hash);
+		ASSERT_EQ (block->hash (), hash);
+		ASSERT_EQ (block->full_hash (), full_hash);
+		ASSERT_EQ (nullptr, uniquer.find (full_hash));
+		// The first copy is deserialized, later copies are found by their serialized hash
+		nano::bufferstream stream1 (bytes.data (), bytes.size ());
+		auto block1 (nano::deserialize_block (stream1, block->type (), &uniquer));
+		ASSERT_NE (nullptr, block1);
+		ASSERT_EQ (*block, *block1);
+		ASSERT_EQ (block1, uniquer.find (full_hash));
+		nano::bufferstream stream2 (bytes.data (), bytes.size ());
+		auto block2 (nano::deserialize_block (stream2, block->type (), &uniquer));
+		ASSERT_EQ (block1, block2);
+		// Truncated input fails
+		nano::bufferstream stream3 (bytes.data (), bytes.size () - 1);
+		ASSERT_EQ (nullptr, nano::deserialize_block (stream3, block->type (), &uniquer));
+	}
+}
+
 TEST (block_builder, from)
 {
 	std::error_code ec;
@@ -111,6 +111,102 @@ TEST (block_store, clear_successor)
 	ASSERT_EQ (0, sideband.successor.number ());
 }
 
+TEST (block_store, block_cache)
+{
+	nano::logger_mt logger;
+	auto store = nano::make_store (logger, nano::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	nano::open_block block1 (0, 1, 0, nano::keypair ().prv, 0, 0);
+	nano::open_block block2 (0, 2, 0, nano::keypair ().prv, 0, 0);
+	auto transaction (store->tx_begin_write ());
+	nano::block_sideband sideband (nano::block_type::open, 0, 0, 0, 5, 0, nano::epoch::epoch_0);
+	store->block_put (transaction, block1.hash (), block1, sideband);
+	store->block_put (transaction, block2.hash (), block2, sideband);
+	ASSERT_EQ (0, store->block_cache.size ());
+	auto hits (store->block_cache.hits.load ());
+	auto get1 (store->block_get (transaction, block1.hash ()));
+	ASSERT_NE (nullptr, get1);
+	ASSERT_EQ (1, store->block_cache.size ());
+	auto get2 (store->block_get (transaction, block1.hash (), &sideband));
+	ASSERT_EQ (get1, get2);
+	ASSERT_EQ (hits + 1, store->block_cache.hits);
+	ASSERT_EQ (5, sideband.height);
+	// The successor of a cached block is read from the database
+	sideband.successor = block2.hash ();
+	store->block_put (transaction, block1.hash (), block1, sideband);
+	ASSERT_EQ (0, store->block_cache.size ());
+	ASSERT_NE (nullptr, store->block_get (transaction, block1.hash (), &sideband));
+	store->block_successor_clear (transaction, block1.hash ());
+	ASSERT_NE (nullptr, store->block_get (transaction, block1.hash (), &sideband));
+	ASSERT_EQ (0, sideband.successor.number ());
+	ASSERT_NE (nullptr, store->block_get (transaction, block1.hash ()));
+	ASSERT_EQ (1, store->block_cache.size ());
+	store->block_del (transaction, block1.hash (), block1.type ());
+	ASSERT_EQ (0, store->block_cache.size ());
+	ASSERT_EQ (nullptr, store->block_get (transaction, block1.hash ()));
+}
+
+TEST (block_cache, eviction)
+{
+	nano::block_cache cache (nullptr, 2);
+	nano::block_sideband sideband;
+	std::vector<uint8_t> value (sizeof (nano::block_hash) + 1);
+	auto block1 (std::make_shared<nano::open_block> (0, 1, 0, nano::keypair ().prv, 0, 0));
+	auto block2 (std::make_shared<nano::open_block> (0, 2, 0, nano::keypair ().prv, 0, 0));
+	auto block3 (std::make_shared<nano::open_block> (0, 3, 0, nano::keypair ().prv, 0, 0));
+	cache.put (block1->hash (), block1, sideband, value.data (), value.size (), 1);
+	cache.put (block2->hash (), block2, sideband, value.data (), value.size (), 1);
+	// Using block1 makes block2 the least recently used
+	ASSERT_EQ (block1, cache.get (block1->hash (), sideband, value.data (), value.size (), 1));
+	cache.put (block3->hash (), block3, sideband, value.data (), value.size (), 1);
+	ASSERT_EQ (2, cache.size ());
+	ASSERT_EQ (nullptr, cache.get (block2->hash (), sideband, value.data (), value.size (), 1));
+	ASSERT_EQ (block1, cache.get (block1->hash (), sideband, value.data (), value.size (), 1));
+	ASSERT_EQ (block3, cache.get (block3->hash (), sideband, value.data (), value.size (), 1));
+	ASSERT_EQ (3, cache.hits);
+	ASSERT_EQ (1, cache.misses);
+	// Entries are only returned for the value they were cached from, apart from the successor
+	value[1] = 1;
+	ASSERT_EQ (block1, cache.get (block1->hash (), sideband, value.data (), value.size (), 1));
+	value[0] = 1;
+	ASSERT_EQ (nullptr, cache.get (block1->hash (), sideband, value.data (), value.size (), 1));
+}
+
+// A read transaction started before a block is rewritten cannot make the old version visible to newer transactions through the cache
+TEST (block_store, block_cache_stale_fill)
+{
+	nano::logger_mt logger;
+	auto store = nano::make_store (logger, nano::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	nano::open_block block1 (0, 1, 0, nano::keypair ().prv, 0, 0);
+	nano::block_sideband sideband (nano::block_type::open, 0, 0, 0, 5, 0, nano::epoch::epoch_0);
+	{
+		auto transaction (store->tx_begin_write ());
+		store->block_put (transaction, block1.hash (), block1, sideband);
+	}
+	auto read_transaction (store->tx_begin_read ());
+	// Rewrite the block with higher work, as done when a dropped election is restarted
+	auto block2 (std::make_shared<nano::open_block> (block1));
+	block2->block_work_set (block1.block_work () + 1);
+	{
+		auto transaction (store->tx_begin_write ());
+		store->block_put (transaction, block1.hash (), *block2, sideband);
+	}
+	ASSERT_EQ (0, store->block_cache.size ());
+	// The old transaction still sees, and caches, the previous version
+	auto block3 (store->block_get (read_transaction, block1.hash ()));
+	ASSERT_NE (nullptr, block3);
+	ASSERT_EQ (block1.block_work (), block3->block_work ());
+	ASSERT_EQ (block1.block_work (), store->block_get (read_transaction, block1.hash ())->block_work ());
+	ASSERT_EQ (1, store->block_cache.size ());
+	// Newer transactions are not served the cached previous version
+	auto block4 (store->block_get (store->tx_begin_read (), block1.hash ()));
+	ASSERT_NE (nullptr, block4);
+	ASSERT_EQ (block2->block_work (), block4->block_work ());
+	ASSERT_NE (block3, block4);
+	ASSERT_EQ (block4, store->block_get (store->tx_begin_read (), block1.hash ()));
+}
+
 TEST (block_store, add_nonempty_block)
 {
 	nano::logger_mt logger;
@@ -144,6 +240,7 @@ TEST (block_store, add_two_items)
 	ASSERT_EQ (nullptr, latest1);
 	nano::open_block block2 (0, 1, 3, nano::keypair ().prv, 0, 0);
 	block2.hashables.account = 3;
+	block2.refresh ();
 	auto hash2 (block2.hash ());
 	block2.signature = nano::sign_message (key1.prv, key1.pub, hash2);
 	auto latest2 (store->block_get (transaction, hash2));
@@ -515,6 +612,7 @@ TEST (block_store, two_block)
 	ASSERT_TRUE (!store->init_error ());
 	nano::open_block block1 (0, 1, 1, nano::keypair ().prv, 0, 0);
 	block1.hashables.account = 1;
+	block1.refresh ();
 	std::vector<nano::block_hash> hashes;
 	std::vector<nano::open_block> blocks;
 	hashes.push_back (block1.hash ());
@@ -794,6 +892,40 @@ TEST (block_store, sequence_increment)
 	ASSERT_EQ (31, vote6->sequence);
 }
 
+TEST (block_store, sequence_increment_batch)
+{
+	nano::logger_mt logger;
+	auto store = nano::make_store (logger, nano::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	nano::keypair key1;
+	nano::keypair key2;
+	std::vector<nano::block_hash> hashes{ 1, 2 };
+	auto transaction (store->tx_begin_write ());
+	auto vote1 (store->vote_generate (transaction, key1.pub, key1.prv, hashes));
+	ASSERT_EQ (1, vote1->sequence);
+	std::vector<std::pair<nano::account, nano::raw_key>> representatives{ { key1.pub, key1.prv }, { key2.pub, key2.prv } };
+	size_t executed (0);
+	auto votes (store->vote_generate (transaction, representatives, hashes, [&executed](std::vector<std::function<void()>> const & tasks_a) {
+		for (auto const & task : tasks_a)
+		{
+			task ();
+			++executed;
+		}
+	}));
+	ASSERT_EQ (2, executed);
+	ASSERT_EQ (2, votes.size ());
+	ASSERT_EQ (key1.pub, votes[0]->account);
+	ASSERT_EQ (2, votes[0]->sequence);
+	ASSERT_FALSE (votes[0]->validate ());
+	ASSERT_EQ (key2.pub, votes[1]->account);
+	ASSERT_EQ (1, votes[1]->sequence);
+	ASSERT_FALSE (votes[1]->validate ());
+	// The cache holds the batch votes
+	ASSERT_EQ (votes[0], store->vote_max (transaction, vote1));
+	auto vote2 (store->vote_generate (transaction, key2.pub, key2.prv, hashes));
+	ASSERT_EQ (2, vote2->sequence);
+}
+
 TEST (mdb_block_store, upgrade_v2_v3)
 {
 	nano::keypair key1;
@@ -2006,6 +2138,33 @@ TEST (block_store, reset_renew_existing_transaction)
 	ASSERT_NE (nullptr, block_existing);
 }
 
+TEST (mdb_block_store, pooled_read_transaction)
+{
+	nano::logger_mt logger;
+	nano::mdb_store store (logger, nano::unique_path ());
+	ASSERT_FALSE (store.init_error ());
+	nano::open_block block (0, 1, 1, nano::keypair ().prv, 0, 0);
+	void * handle (nullptr);
+	{
+		auto transaction (store.tx_begin_read ());
+		handle = transaction.get_handle ();
+		ASSERT_FALSE (store.block_exists (transaction, block.hash ()));
+	}
+	{
+		auto transaction (store.tx_begin_write ());
+		nano::block_sideband sideband (nano::block_type::open, 0, 0, 0, 0, 0, nano::epoch::epoch_0);
+		store.block_put (transaction, block.hash (), block, sideband);
+	}
+	// The handle is renewed from the pool and sees a new snapshot
+	auto transaction1 (store.tx_begin_read ());
+	ASSERT_EQ (handle, transaction1.get_handle ());
+	ASSERT_TRUE (store.block_exists (transaction1, block.hash ()));
+	// Concurrent transactions each get their own handle
+	auto transaction2 (store.tx_begin_read ());
+	ASSERT_NE (transaction1.get_handle (), transaction2.get_handle ());
+	ASSERT_TRUE (store.block_exists (transaction2, block.hash ()));
+}
+
 TEST (block_store, rocksdb_force_test_env_variable)
 {
 	nano::logger_mt logger;
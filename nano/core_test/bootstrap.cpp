@@ -58,6 +58,7 @@ TEST (bulk_pull, end_not_owned)
 	open.hashables.account = key2.pub;
 	open.hashables.representative = key2.pub;
 	open.hashables.source = latest;
+	open.refresh ();
 	open.signature = nano::sign_message (key2.prv, key2.pub, open.hash ());
 	system.nodes[0]->work_generate_blocking (open);
 	ASSERT_EQ (nano::process_result::progress, system.nodes[0]->process (open).code);
@@ -272,6 +273,46 @@ TEST (bootstrap_processor, process_state)
 	node1->stop ();
 }
 
+// Chains longer than one bulk pull server write are sent in several batches
+TEST (bootstrap_processor, process_long_chain)
+{
+	nano::system system;
+	nano::node_config config (nano::get_available_port (), system.logging);
+	config.frontiers_confirmation = nano::frontiers_confirmation_mode::disabled;
+	nano::node_flags node_flags;
+	node_flags.disable_bootstrap_bulk_push_client = true;
+	auto node0 (system.add_node (config, node_flags));
+	nano::block_builder builder;
+	auto latest (node0->latest (nano::test_genesis_key.pub));
+	auto balance (nano::genesis_amount);
+	auto const chain_length (2 * nano::bootstrap_limits::bulk_pull_server_blocks_per_write + 1);
+	for (size_t i (0); i < chain_length; ++i)
+	{
+		balance -= 1;
+		auto send = builder.state ()
+		            .account (nano::test_genesis_key.pub)
+		            .previous (latest)
+		            .representative (nano::test_genesis_key.pub)
+		            .balance (balance)
+		            .link (nano::test_genesis_key.pub)
+		            .sign (nano::test_genesis_key.prv, nano::test_genesis_key.pub)
+		            .work (*system.work.generate (latest))
+		            .build ();
+		latest = send->hash ();
+		ASSERT_EQ (nano::process_result::progress, node0->process (*send).code);
+	}
+	auto node1 (std::make_shared<nano::node> (system.io_ctx, nano::get_available_port (), nano::unique_path (), system.alarm, system.logging, system.work));
+	ASSERT_FALSE (node1->init_error ());
+	node1->bootstrap_initiator.bootstrap (node0->network.endpoint ());
+	system.deadline_set (10s);
+	while (node1->latest (nano::test_genesis_key.pub) != latest)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	ASSERT_EQ (chain_length + 1, node1->ledger.cache.block_count);
+	node1->stop ();
+}
+
 TEST (bootstrap_processor, process_new)
 {
 	nano::system system;
@@ -653,7 +694,7 @@ TEST (bootstrap_processor, lazy_max_pull_count)
 	}
 
 	auto transaction = node1->store.tx_begin_read ();
-	ASSERT_EQ (node1->ledger.cache.unchecked_count, node1->store.unchecked_count (transaction));
+	ASSERT_EQ (node1->ledger.cache.unchecked_count, node1->unchecked.count (transaction));
 	node1->stop ();
 }
 
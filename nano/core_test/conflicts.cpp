@@ -141,6 +141,46 @@ TEST (vote_uniquer, vbh_two)
 	ASSERT_EQ (vote2, uniquer.unique (vote2));
 }
 
+TEST (vote_uniquer, serialized)
+{
+	nano::block_uniquer block_uniquer;
+	nano::vote_uniquer uniquer (block_uniquer);
+	nano::keypair key;
+	auto block1 (std::make_shared<nano::state_block> (0, 0, 0, 0, 0, key.prv, key.pub, 0));
+	auto block2 (std::make_shared<nano::state_block> (1, 0, 0, 0, 0, key.prv, key.pub, 0));
+	std::vector<std::shared_ptr<nano::vote>> votes;
+	votes.push_back (std::make_shared<nano::vote> (key.pub, key.prv, 1, block1));
+	votes.push_back (std::make_shared<nano::vote> (key.pub, key.prv, 2, std::vector<nano::block_hash>{ block1->hash () }));
+	votes.push_back (std::make_shared<nano::vote> (key.pub, key.prv, 3, std::vector<nano::block_hash>{ block1->hash (), block2->hash () }));
+	for (auto & vote : votes)
+	{
+		nano::confirm_ack message (vote);
+		std::vector<uint8_t> bytes;
+		{
+			nano::vectorstream stream (bytes);
+			message.serialize (stream);
+		}
+		auto error (false);
+		nano::bufferstream stream1 (bytes.data (), bytes.size ());
+		nano::message_header header (error, stream1);
+		ASSERT_FALSE (error);
+		auto payload (bytes.data () + bytes.size () - header.payload_length_bytes ());
+		nano::block_hash full_hash;
+		ASSERT_FALSE (nano::vote::serialized_full_hash (header.block_type (), payload, header.payload_length_bytes (), full_hash));
+		ASSERT_EQ (vote->full_hash (), full_hash);
+		ASSERT_TRUE (nano::vote::serialized_full_hash (header.block_type (), payload, header.payload_length_bytes () - 1, full_hash));
+		// The first copy is deserialized, later copies are found by their serialized hash
+		nano::confirm_ack ack1 (error, stream1, header, &uniquer);
+		ASSERT_FALSE (error);
+		ASSERT_EQ (*vote, *ack1.vote);
+		nano::bufferstream stream2 (bytes.data (), bytes.size ());
+		nano::message_header header2 (error, stream2);
+		nano::confirm_ack ack2 (error, stream2, header2, &uniquer);
+		ASSERT_FALSE (error);
+		ASSERT_EQ (ack1.vote, ack2.vote);
+	}
+}
+
 TEST (vote_uniquer, cleanup)
 {
 	nano::block_uniquer block_uniquer;
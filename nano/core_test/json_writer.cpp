@@ -0,0 +1,69 @@
+#include <nano/lib/json_writer.hpp>
+
+#include <gtest/gtest.h>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include <sstream>
+
+namespace
+{
+boost::property_tree::ptree parse (std::string const & json_a)
+{
+	boost::property_tree::ptree result;
+	std::stringstream stream (json_a);
+	boost::property_tree::read_json (stream, result);
+	return result;
+}
+}
+
+TEST (json_writer, empty)
+{
+	nano::json_writer writer;
+	ASSERT_EQ ("\"\"", writer.str ());
+}
+
+TEST (json_writer, nested)
+{
+	nano::json_writer writer;
+	writer.put ("account", "xrb_1");
+	writer.begin_array ("blocks");
+	writer.put ("", "A");
+	writer.put ("", "B");
+	writer.end ();
+	writer.begin_object ("accounts");
+	writer.begin_object ("xrb_2");
+	writer.put ("balance", "10");
+	writer.end ();
+	writer.end ();
+	writer.begin_object ("none");
+	ASSERT_EQ ("{\"account\":\"xrb_1\",\"blocks\":[\"A\",\"B\"],\"accounts\":{\"xrb_2\":{\"balance\":\"10\"}},\"none\":\"\"}", writer.str ());
+}
+
+TEST (json_writer, escape)
+{
+	std::string text ("\"\\/\b\f\n\r\t\x01 end");
+	nano::json_writer writer;
+	writer.put ("text", text);
+	auto tree (parse (writer.str ()));
+	ASSERT_EQ (text, tree.get<std::string> ("text"));
+}
+
+TEST (json_writer, put_tree)
+{
+	boost::property_tree::ptree entry;
+	entry.put ("type", "send");
+	entry.put ("amount", "1");
+	boost::property_tree::ptree list;
+	boost::property_tree::ptree item;
+	item.put ("", "1");
+	list.push_back (std::make_pair ("", item));
+	list.push_back (std::make_pair ("", item));
+	entry.add_child ("list", list);
+	boost::property_tree::ptree expected;
+	expected.add_child ("entry", entry);
+	nano::json_writer writer;
+	writer.put_tree ("entry", entry);
+	ASSERT_EQ (expected, parse (writer.str ()));
+}
@@ -6,6 +6,8 @@
 
 #include <gtest/gtest.h>
 
+#include <fstream>
+
 using namespace std::chrono_literals;
 
 // Init returns an error if it can't open files at the path
@@ -605,6 +607,7 @@ TEST (ledger, representation_changes)
 	ASSERT_EQ (2, rep_weights.representation_get (key1.pub));
 }
 
+// Measures get/add throughput on the sharded weight table with concurrent readers and writers
 TEST (ledger, representation)
 {
 	nano::logger_mt logger;
@@ -858,6 +861,52 @@ TEST (votes, add_existing)
 	}
 }
 
+// Replacing a vote moves the representative's weight between blocks without retallying
+TEST (votes, tally_incremental)
+{
+	nano::system system;
+	nano::node_config node_config (nano::get_available_port (), system.logging);
+	node_config.online_weight_minimum = std::numeric_limits<nano::uint128_t>::max ();
+	node_config.frontiers_confirmation = nano::frontiers_confirmation_mode::disabled;
+	auto & node1 = *system.add_node (node_config);
+	nano::genesis genesis;
+	nano::keypair key1;
+	auto send1 (std::make_shared<nano::send_block> (genesis.hash (), key1.pub, nano::genesis_amount - nano::Gxrb_ratio, nano::test_genesis_key.prv, nano::test_genesis_key.pub, 0));
+	node1.work_generate_blocking (*send1);
+	{
+		auto transaction (node1.store.tx_begin_write ());
+		ASSERT_EQ (nano::process_result::progress, node1.ledger.process (transaction, *send1).code);
+	}
+	auto weight (node1.ledger.weight (nano::test_genesis_key.pub));
+	node1.active.start (send1);
+	auto vote1 (std::make_shared<nano::vote> (nano::test_genesis_key.pub, nano::test_genesis_key.prv, 1, send1));
+	ASSERT_EQ (nano::vote_code::vote, node1.active.vote (vote1));
+	nano::keypair key2;
+	auto send2 (std::make_shared<nano::send_block> (genesis.hash (), key2.pub, nano::genesis_amount - nano::Gxrb_ratio, nano::test_genesis_key.prv, nano::test_genesis_key.pub, 0));
+	node1.work_generate_blocking (*send2);
+	ASSERT_FALSE (node1.active.publish (send2));
+	nano::unique_lock<std::mutex> lock (node1.active.mutex);
+	auto votes1 (node1.active.roots.find (send1->qualified_root ())->election);
+	ASSERT_EQ (weight, votes1->last_tally[send1->hash ()]);
+	ASSERT_EQ (votes1->last_tally.end (), votes1->last_tally.find (send2->hash ()));
+	auto vote2 (std::make_shared<nano::vote> (nano::test_genesis_key.pub, nano::test_genesis_key.prv, 2, send2));
+	votes1->last_votes[nano::test_genesis_key.pub].time = std::chrono::steady_clock::now () - std::chrono::seconds (20);
+	lock.unlock ();
+	ASSERT_EQ (nano::vote_code::vote, node1.active.vote (vote2));
+	lock.lock ();
+	// send1 keeps the zero weight placeholder vote the election started with
+	ASSERT_EQ (0, votes1->last_tally[send1->hash ()]);
+	ASSERT_EQ (weight, votes1->last_tally[send2->hash ()]);
+	auto winner (*votes1->tally ().begin ());
+	ASSERT_EQ (*send2, *winner.second);
+	ASSERT_EQ (weight, winner.first);
+	// A full refresh agrees with the incremental tally
+	votes1->refresh_weights ();
+	ASSERT_EQ (2, votes1->last_tally.size ());
+	ASSERT_EQ (0, votes1->last_tally[send1->hash ()]);
+	ASSERT_EQ (weight, votes1->last_tally[send2->hash ()]);
+}
+
 // Lower sequence numbers are ignored
 TEST (votes, add_old)
 {
@@ -2676,10 +2725,10 @@ TEST (ledger, unchecked_epoch)
 	node1.block_processor.flush ();
 	{
 		auto transaction (node1.store.tx_begin_read ());
-		auto unchecked_count (node1.store.unchecked_count (transaction));
+		auto unchecked_count (node1.unchecked.count (transaction));
 		ASSERT_EQ (unchecked_count, 1);
 		ASSERT_EQ (unchecked_count, node1.ledger.cache.unchecked_count);
-		auto blocks (node1.store.unchecked_get (transaction, epoch1->previous ()));
+		auto blocks (node1.unchecked.get (transaction, epoch1->previous ()));
 		ASSERT_EQ (blocks.size (), 1);
 		ASSERT_EQ (blocks[0].verified, nano::signature_verification::valid_epoch);
 	}
@@ -2689,7 +2738,7 @@ TEST (ledger, unchecked_epoch)
 	{
 		auto transaction (node1.store.tx_begin_read ());
 		ASSERT_TRUE (node1.store.block_exists (transaction, epoch1->hash ()));
-		auto unchecked_count (node1.store.unchecked_count (transaction));
+		auto unchecked_count (node1.unchecked.count (transaction));
 		ASSERT_EQ (unchecked_count, 0);
 		ASSERT_EQ (unchecked_count, node1.ledger.cache.unchecked_count);
 		nano::account_info info;
@@ -2721,10 +2770,10 @@ TEST (ledger, unchecked_epoch_invalid)
 	node1.block_processor.flush ();
 	{
 		auto transaction (node1.store.tx_begin_read ());
-		auto unchecked_count (node1.store.unchecked_count (transaction));
+		auto unchecked_count (node1.unchecked.count (transaction));
 		ASSERT_EQ (unchecked_count, 2);
 		ASSERT_EQ (unchecked_count, node1.ledger.cache.unchecked_count);
-		auto blocks (node1.store.unchecked_get (transaction, epoch1->previous ()));
+		auto blocks (node1.unchecked.get (transaction, epoch1->previous ()));
 		ASSERT_EQ (blocks.size (), 2);
 		ASSERT_EQ (blocks[0].verified, nano::signature_verification::valid);
 		ASSERT_EQ (blocks[1].verified, nano::signature_verification::valid);
@@ -2737,7 +2786,7 @@ TEST (ledger, unchecked_epoch_invalid)
 		ASSERT_FALSE (node1.store.block_exists (transaction, epoch1->hash ()));
 		ASSERT_TRUE (node1.store.block_exists (transaction, epoch2->hash ()));
 		ASSERT_TRUE (node1.active.empty ());
-		auto unchecked_count (node1.store.unchecked_count (transaction));
+		auto unchecked_count (node1.unchecked.count (transaction));
 		ASSERT_EQ (unchecked_count, 0);
 		ASSERT_EQ (unchecked_count, node1.ledger.cache.unchecked_count);
 		nano::account_info info;
@@ -2765,10 +2814,10 @@ TEST (ledger, unchecked_open)
 	node1.block_processor.flush ();
 	{
 		auto transaction (node1.store.tx_begin_read ());
-		auto unchecked_count (node1.store.unchecked_count (transaction));
+		auto unchecked_count (node1.unchecked.count (transaction));
 		ASSERT_EQ (unchecked_count, 1);
 		ASSERT_EQ (unchecked_count, node1.ledger.cache.unchecked_count);
-		auto blocks (node1.store.unchecked_get (transaction, open1->source ()));
+		auto blocks (node1.unchecked.get (transaction, open1->source ()));
 		ASSERT_EQ (blocks.size (), 1);
 		ASSERT_EQ (blocks[0].verified, nano::signature_verification::valid);
 	}
@@ -2777,7 +2826,7 @@ TEST (ledger, unchecked_open)
 	{
 		auto transaction (node1.store.tx_begin_read ());
 		ASSERT_TRUE (node1.store.block_exists (transaction, open1->hash ()));
-		auto unchecked_count (node1.store.unchecked_count (transaction));
+		auto unchecked_count (node1.unchecked.count (transaction));
 		ASSERT_EQ (unchecked_count, 0);
 		ASSERT_EQ (unchecked_count, node1.ledger.cache.unchecked_count);
 	}
@@ -2803,10 +2852,10 @@ TEST (ledger, unchecked_receive)
 	// Previous block for receive1 is unknown, signature cannot be validated
 	{
 		auto transaction (node1.store.tx_begin_read ());
-		auto unchecked_count (node1.store.unchecked_count (transaction));
+		auto unchecked_count (node1.unchecked.count (transaction));
 		ASSERT_EQ (unchecked_count, 1);
 		ASSERT_EQ (unchecked_count, node1.ledger.cache.unchecked_count);
-		auto blocks (node1.store.unchecked_get (transaction, receive1->previous ()));
+		auto blocks (node1.unchecked.get (transaction, receive1->previous ()));
 		ASSERT_EQ (blocks.size (), 1);
 		ASSERT_EQ (blocks[0].verified, nano::signature_verification::unknown);
 	}
@@ -2815,10 +2864,10 @@ TEST (ledger, unchecked_receive)
 	// Previous block for receive1 is known, signature was validated
 	{
 		auto transaction (node1.store.tx_begin_read ());
-		auto unchecked_count (node1.store.unchecked_count (transaction));
+		auto unchecked_count (node1.unchecked.count (transaction));
 		ASSERT_EQ (unchecked_count, 1);
 		ASSERT_EQ (unchecked_count, node1.ledger.cache.unchecked_count);
-		auto blocks (node1.store.unchecked_get (transaction, receive1->source ()));
+		auto blocks (node1.unchecked.get (transaction, receive1->source ()));
 		ASSERT_EQ (blocks.size (), 1);
 		ASSERT_EQ (blocks[0].verified, nano::signature_verification::valid);
 	}
@@ -2827,7 +2876,7 @@ TEST (ledger, unchecked_receive)
 	{
 		auto transaction (node1.store.tx_begin_read ());
 		ASSERT_TRUE (node1.store.block_exists (transaction, receive1->hash ()));
-		auto unchecked_count (node1.store.unchecked_count (transaction));
+		auto unchecked_count (node1.unchecked.count (transaction));
 		ASSERT_EQ (unchecked_count, 0);
 		ASSERT_EQ (unchecked_count, node1.ledger.cache.unchecked_count);
 	}
@@ -2895,3 +2944,83 @@ TEST (ledger, zero_rep)
 	ASSERT_EQ (nano::genesis_amount, node1.ledger.cache.rep_weights.representation_get (nano::test_genesis_key.pub));
 	ASSERT_EQ (0, node1.ledger.cache.rep_weights.representation_get (0));
 }
+
+TEST (ledger, cache_snapshot)
+{
+	nano::logger_mt logger;
+	auto path (nano::unique_path ());
+	auto store = nano::make_store (logger, path);
+	ASSERT_TRUE (!store->init_error ());
+	nano::stat stats;
+	nano::ledger ledger (*store, stats);
+	nano::genesis genesis;
+	nano::keypair key1;
+	nano::work_pool pool (std::numeric_limits<unsigned>::max ());
+	{
+		auto transaction (store->tx_begin_write ());
+		store->initialize (transaction, genesis, ledger.cache);
+		nano::state_block change (nano::test_genesis_key.pub, genesis.hash (), key1.pub, nano::genesis_amount, 0, nano::test_genesis_key.prv, nano::test_genesis_key.pub, *pool.generate (genesis.hash ()));
+		ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, change).code);
+	}
+	auto snapshot_path (path / "ledger_cache.snapshot");
+	ASSERT_FALSE (ledger.cache_snapshot_write (snapshot_path));
+	ASSERT_TRUE (boost::filesystem::exists (snapshot_path));
+	// Generating nothing shows the weights and counts come from the snapshot
+	nano::generate_cache generate_cache;
+	generate_cache.reps = false;
+	generate_cache.cemented_count = false;
+	generate_cache.unchecked_count = false;
+	nano::ledger ledger2 (*store, stats, generate_cache, snapshot_path);
+	ASSERT_FALSE (boost::filesystem::exists (snapshot_path));
+	ASSERT_EQ (nano::genesis_amount, ledger2.weight (key1.pub));
+	ASSERT_EQ (0, ledger2.weight (nano::test_genesis_key.pub));
+	ASSERT_EQ (1, ledger2.cache.cemented_count);
+	ASSERT_EQ (2, ledger2.cache.block_count);
+	// A consumed snapshot is not loaded again
+	nano::ledger ledger3 (*store, stats, generate_cache, snapshot_path);
+	ASSERT_EQ (0, ledger3.weight (key1.pub));
+}
+
+TEST (ledger, cache_snapshot_stale)
+{
+	nano::logger_mt logger;
+	auto path (nano::unique_path ());
+	auto store = nano::make_store (logger, path);
+	ASSERT_TRUE (!store->init_error ());
+	nano::stat stats;
+	nano::ledger ledger (*store, stats);
+	nano::genesis genesis;
+	nano::keypair key1;
+	nano::work_pool pool (std::numeric_limits<unsigned>::max ());
+	{
+		auto transaction (store->tx_begin_write ());
+		store->initialize (transaction, genesis, ledger.cache);
+	}
+	auto snapshot_path (path / "ledger_cache.snapshot");
+	ASSERT_FALSE (ledger.cache_snapshot_write (snapshot_path));
+	{
+		auto transaction (store->tx_begin_write ());
+		nano::state_block change (nano::test_genesis_key.pub, genesis.hash (), key1.pub, nano::genesis_amount, 0, nano::test_genesis_key.prv, nano::test_genesis_key.pub, *pool.generate (genesis.hash ()));
+		ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, change).code);
+	}
+	// The snapshot no longer matches the store so the cache is generated instead
+	nano::ledger ledger2 (*store, stats, nano::generate_cache (), snapshot_path);
+	ASSERT_FALSE (boost::filesystem::exists (snapshot_path));
+	ASSERT_EQ (nano::genesis_amount, ledger2.weight (key1.pub));
+	ASSERT_EQ (0, ledger2.weight (nano::test_genesis_key.pub));
+
+	// Corrupted snapshots are rejected by the checksum
+	ASSERT_FALSE (ledger2.cache_snapshot_write (snapshot_path));
+	{
+		std::fstream file (snapshot_path.string (), std::ios::in | std::ios::out | std::ios::binary);
+		file.seekg (-1, std::ios::end);
+		auto last (file.get ());
+		file.seekp (-1, std::ios::end);
+		file.put (static_cast<char> (last ^ 1));
+	}
+	nano::generate_cache generate_cache;
+	generate_cache.reps = false;
+	nano::ledger ledger3 (*store, stats, generate_cache, snapshot_path);
+	ASSERT_FALSE (boost::filesystem::exists (snapshot_path));
+	ASSERT_EQ (0, ledger3.weight (key1.pub));
+}
@@ -247,6 +247,26 @@ TEST (network, send_discarded_publish)
 	ASSERT_EQ (genesis.hash (), node2.latest (nano::test_genesis_key.pub));
 }
 
+TEST (network, broadcast)
+{
+	nano::system system (3);
+	auto & node1 (*system.nodes[0]);
+	auto channels (node1.network.list (std::numeric_limits<size_t>::max ()));
+	ASSERT_FALSE (channels.empty ());
+	auto block (std::make_shared<nano::send_block> (1, 1, 2, nano::keypair ().prv, 4, *system.work.generate (nano::root (1))));
+	nano::publish publish (block);
+	node1.network.broadcast (channels, publish);
+	ASSERT_EQ (channels.size (), node1.stats.count (nano::stat::type::message, nano::stat::detail::publish, nano::stat::dir::out));
+	auto received = [&system]() {
+		return system.nodes[1]->stats.count (nano::stat::type::message, nano::stat::detail::publish, nano::stat::dir::in) + system.nodes[2]->stats.count (nano::stat::type::message, nano::stat::detail::publish, nano::stat::dir::in);
+	};
+	system.deadline_set (10s);
+	while (received () < channels.size ())
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+}
+
 TEST (network, send_invalid_publish)
 {
 	nano::system system (2);
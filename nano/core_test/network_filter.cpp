@@ -0,0 +1,79 @@
+#include <nano/core_test/testutil.hpp>
+#include <nano/node/common.hpp>
+#include <nano/node/testing.hpp>
+#include <nano/secure/buffer.hpp>
+#include <nano/secure/network_filter.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+std::vector<uint8_t> block_bytes (nano::block const & block_a)
+{
+	std::vector<uint8_t> bytes;
+	{
+		nano::vectorstream stream (bytes);
+		block_a.serialize (stream);
+	}
+	return bytes;
+}
+}
+
+TEST (network_filter, unit)
+{
+	nano::genesis genesis;
+	nano::network_filter filter (1);
+	auto bytes1 (block_bytes (*genesis.open));
+	nano::network_filter::digest_t digest (0);
+	ASSERT_FALSE (filter.apply (bytes1.data (), bytes1.size (), &digest));
+	ASSERT_EQ (filter.hash (bytes1.data (), bytes1.size ()), digest);
+	ASSERT_TRUE (filter.apply (bytes1.data (), bytes1.size ()));
+	ASSERT_TRUE (filter.apply (bytes1.data (), bytes1.size ()));
+	filter.clear (digest);
+	ASSERT_FALSE (filter.apply (bytes1.data (), bytes1.size ()));
+	filter.clear (*genesis.open);
+	ASSERT_FALSE (filter.apply (bytes1.data (), bytes1.size ()));
+	// With a single slot any other item evicts the first
+	nano::state_block block2 (nano::test_genesis_key.pub, genesis.hash (), nano::test_genesis_key.pub, nano::genesis_amount - 10, 1, nano::test_genesis_key.prv, nano::test_genesis_key.pub, 0);
+	auto bytes2 (block_bytes (block2));
+	ASSERT_FALSE (filter.apply (bytes2.data (), bytes2.size ()));
+	// Clearing an evicted digest must not clear the current one
+	filter.clear (digest);
+	ASSERT_TRUE (filter.apply (bytes2.data (), bytes2.size ()));
+	ASSERT_FALSE (filter.apply (bytes1.data (), bytes1.size ()));
+	filter.clear ();
+	ASSERT_FALSE (filter.apply (bytes1.data (), bytes1.size ()));
+}
+
+TEST (network_filter, keyed)
+{
+	nano::genesis genesis;
+	nano::network_filter filter1 (1);
+	nano::network_filter filter2 (1);
+	auto bytes (block_bytes (*genesis.open));
+	ASSERT_NE (filter1.hash (bytes.data (), bytes.size ()), filter2.hash (bytes.data (), bytes.size ()));
+}
+
+TEST (network_filter, duplicate_publish)
+{
+	nano::system system (2);
+	auto & node1 (*system.nodes[0]);
+	auto & node2 (*system.nodes[1]);
+	nano::genesis genesis;
+	auto block (std::make_shared<nano::state_block> (nano::test_genesis_key.pub, genesis.hash (), nano::test_genesis_key.pub, nano::genesis_amount - 10, nano::keypair ().pub, nano::test_genesis_key.prv, nano::test_genesis_key.pub, *system.work.generate (genesis.hash ())));
+	node1.network.flood_block (block);
+	system.deadline_set (10s);
+	while (node2.stats.count (nano::stat::type::filter, nano::stat::detail::unique_publish, nano::stat::dir::in) == 0)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	node1.network.flood_block (block);
+	while (node2.stats.count (nano::stat::type::filter, nano::stat::detail::duplicate_publish, nano::stat::dir::in) == 0)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	ASSERT_EQ (1, node2.stats.count (nano::stat::type::filter, nano::stat::detail::unique_publish, nano::stat::dir::in));
+	ASSERT_EQ (1, node2.stats.count (nano::stat::type::message, nano::stat::detail::publish, nano::stat::dir::in));
+}
@@ -282,7 +282,7 @@ TEST (node, auto_bootstrap)
 	}
 
 	auto transaction = node1->store.tx_begin_read ();
-	ASSERT_EQ (node1->ledger.cache.unchecked_count, node1->store.unchecked_count (transaction));
+	ASSERT_EQ (node1->ledger.cache.unchecked_count, node1->unchecked.count (transaction));
 
 	node1->stop ();
 }
@@ -2383,6 +2383,37 @@ TEST (node, stat_counting)
 	ASSERT_EQ (1, node1.stats.count (nano::stat::type::ledger, nano::stat::detail::receive, nano::stat::dir::in));
 }
 
+TEST (node, stat_counting_concurrent)
+{
+	nano::stat stats;
+	std::vector<std::thread> threads;
+	for (auto i (0); i < 8; ++i)
+	{
+		threads.emplace_back ([&stats]() {
+			for (auto j (0); j < 1000; ++j)
+			{
+				stats.inc (nano::stat::type::ledger, nano::stat::detail::send, nano::stat::dir::in);
+			}
+		});
+	}
+	for (auto & thread : threads)
+	{
+		thread.join ();
+	}
+	ASSERT_EQ (8000, stats.count (nano::stat::type::ledger, nano::stat::dir::in));
+	ASSERT_EQ (8000, stats.count (nano::stat::type::ledger, nano::stat::detail::send, nano::stat::dir::in));
+	// Observers see totals including increments made before they were added
+	uint64_t observed (0);
+	stats.observe_count (nano::stat::type::ledger, nano::stat::detail::send, nano::stat::dir::in, [&observed](uint64_t, uint64_t new_a) {
+		observed = new_a;
+	});
+	stats.inc (nano::stat::type::ledger, nano::stat::detail::send, nano::stat::dir::in);
+	ASSERT_EQ (8001, observed);
+	ASSERT_EQ (8001, stats.count (nano::stat::type::ledger, nano::stat::detail::send, nano::stat::dir::in));
+	stats.clear ();
+	ASSERT_EQ (0, stats.count (nano::stat::type::ledger, nano::stat::dir::in));
+}
+
 TEST (node, online_reps)
 {
 	nano::system system (1);
@@ -3098,6 +3129,29 @@ TEST (node, block_processor_reject_state)
 	ASSERT_TRUE (node.ledger.block_exists (send2->hash ()));
 }
 
+// Legacy blocks are signature checked from their predecessor's account before reaching the ledger
+TEST (node, block_processor_reject_legacy)
+{
+	nano::system system (1);
+	auto & node (*system.nodes[0]);
+	nano::genesis genesis;
+	auto send1 (std::make_shared<nano::send_block> (genesis.hash (), nano::test_genesis_key.pub, nano::genesis_amount - nano::Gxrb_ratio, nano::test_genesis_key.prv, nano::test_genesis_key.pub, 0));
+	node.work_generate_blocking (*send1);
+	send1->signature.bytes[0] ^= 1;
+	node.process_active (send1);
+	node.block_processor.flush ();
+	ASSERT_FALSE (node.ledger.block_exists (send1->hash ()));
+	auto send2 (std::make_shared<nano::send_block> (genesis.hash (), nano::test_genesis_key.pub, nano::genesis_amount - 2 * nano::Gxrb_ratio, nano::test_genesis_key.prv, nano::test_genesis_key.pub, 0));
+	node.work_generate_blocking (*send2);
+	node.process_active (send2);
+	node.block_processor.flush ();
+	ASSERT_TRUE (node.ledger.block_exists (send2->hash ()));
+	// Already processed blocks skip signature verification and are classified by the ledger
+	node.process_active (send2);
+	node.block_processor.flush ();
+	ASSERT_TRUE (node.ledger.block_exists (send2->hash ()));
+}
+
 TEST (node, block_processor_full)
 {
 	nano::system system;
@@ -3155,6 +3209,60 @@ TEST (node, block_processor_half_full)
 	ASSERT_FALSE (node.block_processor.full ());
 }
 
+TEST (node, block_processor_priority_buckets)
+{
+	auto recent (nano::prioritized_blocks::recent_age - std::chrono::seconds (1));
+	auto quiet (nano::prioritized_blocks::recent_age);
+	ASSERT_EQ (0, nano::prioritized_blocks::bucket (0, recent));
+	ASSERT_EQ (1, nano::prioritized_blocks::bucket (0, quiet));
+	ASSERT_EQ (2, nano::prioritized_blocks::bucket (nano::kxrb_ratio, recent));
+	ASSERT_EQ (4, nano::prioritized_blocks::bucket (nano::Mxrb_ratio, recent));
+	ASSERT_EQ (nano::prioritized_blocks::bucket_count - 1, nano::prioritized_blocks::bucket (nano::genesis_amount, quiet));
+	for (size_t i (1); i < nano::prioritized_blocks::bucket_count; ++i)
+	{
+		ASSERT_GE (nano::prioritized_blocks::quantum (i), nano::prioritized_blocks::quantum (i - 1));
+	}
+}
+
+// A block in a high priority bucket is served ahead of a backlog of dust
+TEST (node, block_processor_priority_round_robin)
+{
+	nano::keypair key;
+	auto make_info = [&key](uint64_t balance_a) {
+		auto block (std::make_shared<nano::state_block> (nano::keypair ().pub, 0, key.pub, balance_a, 0, key.prv, key.pub, 0));
+		return nano::unchecked_info (block, block->account (), 0, nano::signature_verification::valid);
+	};
+	nano::prioritized_blocks blocks;
+	for (auto i (0); i < 100; ++i)
+	{
+		auto info (make_info (i));
+		blocks.push (info, info.account, 0);
+	}
+	auto important (make_info (1000));
+	auto last_bucket (nano::prioritized_blocks::bucket_count - 1);
+	blocks.push (important, important.account, last_bucket);
+	ASSERT_EQ (101, blocks.size ());
+	ASSERT_EQ (1, blocks.bucket_size (last_bucket));
+	blocks.pop ();
+	ASSERT_EQ (important.block, blocks.pop ().block);
+	ASSERT_EQ (0, blocks.bucket_size (last_bucket));
+	while (!blocks.empty ())
+	{
+		blocks.pop ();
+	}
+	// Later blocks of an account join the bucket its earlier blocks are queued in
+	auto first (make_info (1));
+	blocks.push (first, key.pub, last_bucket);
+	auto second (make_info (2));
+	blocks.push (second, key.pub, 0);
+	ASSERT_EQ (2, blocks.bucket_size (last_bucket));
+	ASSERT_EQ (first.block, blocks.pop ().block);
+	ASSERT_EQ (second.block, blocks.pop ().block);
+	// Once the account has nothing queued it is bucketed afresh
+	blocks.push (first, key.pub, 0);
+	ASSERT_EQ (1, blocks.bucket_size (0));
+}
+
 TEST (node, confirm_back)
 {
 	nano::system system (1);
@@ -3311,7 +3419,7 @@ TEST (node, unchecked_cleanup)
 	node.config.unchecked_cutoff_time = std::chrono::seconds (2);
 	{
 		auto transaction (node.store.tx_begin_read ());
-		auto unchecked_count (node.store.unchecked_count (transaction));
+		auto unchecked_count (node.unchecked.count (transaction));
 		ASSERT_EQ (unchecked_count, 1);
 		ASSERT_EQ (unchecked_count, node.ledger.cache.unchecked_count);
 	}
@@ -3319,7 +3427,7 @@ TEST (node, unchecked_cleanup)
 	node.unchecked_cleanup ();
 	{
 		auto transaction (node.store.tx_begin_read ());
-		auto unchecked_count (node.store.unchecked_count (transaction));
+		auto unchecked_count (node.unchecked.count (transaction));
 		ASSERT_EQ (unchecked_count, 1);
 		ASSERT_EQ (unchecked_count, node.ledger.cache.unchecked_count);
 	}
@@ -3327,7 +3435,7 @@ TEST (node, unchecked_cleanup)
 	node.unchecked_cleanup ();
 	{
 		auto transaction (node.store.tx_begin_read ());
-		auto unchecked_count (node.store.unchecked_count (transaction));
+		auto unchecked_count (node.unchecked.count (transaction));
 		ASSERT_EQ (unchecked_count, 0);
 		ASSERT_EQ (unchecked_count, node.ledger.cache.unchecked_count);
 	}
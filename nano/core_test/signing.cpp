@@ -42,6 +42,39 @@ TEST (signature_checker, bulk_single_thread)
 	ASSERT_TRUE (all_valid);
 }
 
+TEST (signature_checker, bulk_custom_batch_size)
+{
+	nano::keypair key;
+	nano::state_block block (key.pub, 0, key.pub, 0, 0, key.prv, key.pub, 0);
+	// Small batches so the set is split over the thread pool with an uneven remainder
+	nano::signature_checker checker (2, 32);
+	std::vector<nano::uint256_union> hashes;
+	size_t size (1000);
+	hashes.reserve (size);
+	std::vector<unsigned char const *> messages;
+	messages.reserve (size);
+	std::vector<size_t> lengths;
+	lengths.reserve (size);
+	std::vector<unsigned char const *> pub_keys;
+	pub_keys.reserve (size);
+	std::vector<unsigned char const *> signatures;
+	signatures.reserve (size);
+	std::vector<int> verifications;
+	verifications.resize (size);
+	for (auto i (0); i < size; ++i)
+	{
+		hashes.push_back (block.hash ());
+		messages.push_back (hashes.back ().bytes.data ());
+		lengths.push_back (sizeof (decltype (hashes)::value_type));
+		pub_keys.push_back (block.hashables.account.bytes.data ());
+		signatures.push_back (block.signature.bytes.data ());
+	}
+	nano::signature_check_set check = { size, messages.data (), lengths.data (), pub_keys.data (), signatures.data (), verifications.data () };
+	checker.verify (check);
+	bool all_valid = std::all_of (verifications.cbegin (), verifications.cend (), [](auto verification) { return verification == 1; });
+	ASSERT_TRUE (all_valid);
+}
+
 TEST (signature_checker, many_multi_threaded)
 {
 	nano::signature_checker checker (4);
@@ -139,3 +139,112 @@ TEST (socket, concurrent_writes)
 		t.join ();
 	}
 }
+
+namespace
+{
+/** Connects a multi_writer client to a new server socket, polling \p system_a until the server has accepted it */
+void connect_multi_writer (nano::system & system_a, std::shared_ptr<nano::server_socket> & server_a, std::shared_ptr<nano::socket> & client_a, std::shared_ptr<nano::socket> & connection_a)
+{
+	auto node (system_a.nodes[0]);
+	auto port (nano::get_available_port ());
+	server_a = std::make_shared<nano::server_socket> (node, boost::asio::ip::tcp::endpoint (boost::asio::ip::address_v4::any (), port), 1, nano::socket::concurrency::multi_writer);
+	boost::system::error_code ec;
+	server_a->start (ec);
+	ASSERT_FALSE (ec);
+	server_a->on_connection ([&connection_a](std::shared_ptr<nano::socket> new_connection, boost::system::error_code const & ec_a) {
+		if (!ec_a)
+		{
+			connection_a = new_connection;
+		}
+		return true;
+	});
+	client_a = std::make_shared<nano::socket> (node, boost::none, nano::socket::concurrency::multi_writer);
+	auto connected (false);
+	client_a->async_connect (boost::asio::ip::tcp::endpoint (boost::asio::ip::address_v4::loopback (), port), [&connected](boost::system::error_code const & ec_a) {
+		EXPECT_FALSE (ec_a);
+		connected = true;
+	});
+	system_a.deadline_set (5s);
+	while (!connected || connection_a == nullptr)
+	{
+		ASSERT_NO_ERROR (system_a.poll ());
+	}
+}
+}
+
+TEST (socket, batched_write_callbacks)
+{
+	nano::system system (1);
+	std::shared_ptr<nano::server_socket> server;
+	std::shared_ptr<nano::socket> client;
+	std::shared_ptr<nano::socket> connection;
+	connect_multi_writer (system, server, client, connection);
+	ASSERT_NE (nullptr, connection);
+
+	// Queued without polling, so the messages are written over several vectored writes
+	size_t const message_count (nano::socket::write_batch_max * 2 + 1);
+	std::vector<size_t> sizes (message_count, 0);
+	std::vector<unsigned> calls (message_count, 0);
+	size_t completed (0);
+	for (size_t i (0); i < message_count; ++i)
+	{
+		client->async_write (nano::shared_const_buffer (std::vector<uint8_t> (i + 1, 'A')), [i, &sizes, &calls, &completed](boost::system::error_code const & ec_a, size_t size_a) {
+			EXPECT_FALSE (ec_a);
+			sizes[i] = size_a;
+			++calls[i];
+			++completed;
+		});
+	}
+	system.deadline_set (5s);
+	while (completed < message_count)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	for (size_t i (0); i < message_count; ++i)
+	{
+		ASSERT_EQ (1, calls[i]);
+		ASSERT_EQ (i + 1, sizes[i]);
+	}
+	ASSERT_EQ (0, system.nodes[0]->stats.count (nano::stat::type::tcp, nano::stat::detail::tcp_write_drop, nano::stat::dir::out));
+}
+
+TEST (socket, write_queue_bytes_drop)
+{
+	nano::system system (1);
+	auto node (system.nodes[0]);
+	std::shared_ptr<nano::server_socket> server;
+	std::shared_ptr<nano::socket> client;
+	std::shared_ptr<nano::socket> connection;
+	connect_multi_writer (system, server, client, connection);
+	ASSERT_NE (nullptr, connection);
+
+	// The first message is accepted whatever its size, the second one would exceed the byte limit
+	size_t const message_size (nano::socket::queue_bytes_max / 2 + 1);
+	auto completed (0);
+	for (auto i (0); i < 2; ++i)
+	{
+		client->async_write (nano::shared_const_buffer (std::vector<uint8_t> (message_size, 'A')), [&completed](boost::system::error_code const & ec_a, size_t size_a) {
+			EXPECT_FALSE (ec_a);
+			++completed;
+		});
+	}
+	system.deadline_set (5s);
+	while (completed < 1)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	ASSERT_EQ (1, completed);
+	ASSERT_EQ (1, node->stats.count (nano::stat::type::tcp, nano::stat::detail::tcp_write_drop, nano::stat::dir::out));
+
+	// Once drained, a message larger than the limit is accepted
+	client->async_write (nano::shared_const_buffer (std::vector<uint8_t> (nano::socket::queue_bytes_max * 2, 'B')), [&completed](boost::system::error_code const & ec_a, size_t size_a) {
+		EXPECT_FALSE (ec_a);
+		++completed;
+	});
+	system.deadline_set (5s);
+	while (completed < 2)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	ASSERT_EQ (1, node->stats.count (nano::stat::type::tcp, nano::stat::detail::tcp_write_drop, nano::stat::dir::out));
+}
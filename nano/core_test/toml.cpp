@@ -211,6 +211,8 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.websocket_config.enabled, defaults.node.websocket_config.enabled);
 	ASSERT_EQ (conf.node.websocket_config.address, defaults.node.websocket_config.address);
 	ASSERT_EQ (conf.node.websocket_config.port, defaults.node.websocket_config.port);
+	ASSERT_EQ (conf.node.websocket_config.send_queue_max, defaults.node.websocket_config.send_queue_max);
+	ASSERT_EQ (conf.node.websocket_config.overflow_policy, defaults.node.websocket_config.overflow_policy);
 
 	ASSERT_EQ (conf.node.callback_address, defaults.node.callback_address);
 	ASSERT_EQ (conf.node.callback_port, defaults.node.callback_port);
@@ -251,6 +253,9 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.rocksdb_config.memtable_size, defaults.node.rocksdb_config.memtable_size);
 	ASSERT_EQ (conf.node.rocksdb_config.num_memtables, defaults.node.rocksdb_config.num_memtables);
 	ASSERT_EQ (conf.node.rocksdb_config.total_memtable_size, defaults.node.rocksdb_config.total_memtable_size);
+	ASSERT_EQ (conf.node.rocksdb_config.table_profiles, defaults.node.rocksdb_config.table_profiles);
+	ASSERT_EQ (conf.node.rocksdb_config.unchecked_block_cache, defaults.node.rocksdb_config.unchecked_block_cache);
+	ASSERT_EQ (conf.node.rocksdb_config.unchecked_ttl, defaults.node.rocksdb_config.unchecked_ttl);
 }
 
 TEST (toml, optional_child)
@@ -484,6 +489,8 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	address = "0:0:0:0:0:ffff:7f01:101"
 	enable = true
 	port = 999
+	send_queue_max = 999
+	overflow_policy = "disconnect"
 
 	[node.rocksdb]
 	enable = true
@@ -496,6 +503,9 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	memtable_size = 128
 	num_memtables = 3
 	total_memtable_size = 0
+	table_profiles = false
+	unchecked_block_cache = 32
+	unchecked_ttl = 120
 
 	[node.experimental]
 	secondary_work_peers = ["test.org:998"]
@@ -601,6 +611,8 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.websocket_config.enabled, defaults.node.websocket_config.enabled);
 	ASSERT_NE (conf.node.websocket_config.address, defaults.node.websocket_config.address);
 	ASSERT_NE (conf.node.websocket_config.port, defaults.node.websocket_config.port);
+	ASSERT_NE (conf.node.websocket_config.send_queue_max, defaults.node.websocket_config.send_queue_max);
+	ASSERT_NE (conf.node.websocket_config.overflow_policy, defaults.node.websocket_config.overflow_policy);
 
 	ASSERT_NE (conf.node.callback_address, defaults.node.callback_address);
 	ASSERT_NE (conf.node.callback_port, defaults.node.callback_port);
@@ -641,6 +653,9 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.rocksdb_config.memtable_size, defaults.node.rocksdb_config.memtable_size);
 	ASSERT_NE (conf.node.rocksdb_config.num_memtables, defaults.node.rocksdb_config.num_memtables);
 	ASSERT_NE (conf.node.rocksdb_config.total_memtable_size, defaults.node.rocksdb_config.total_memtable_size);
+	ASSERT_NE (conf.node.rocksdb_config.table_profiles, defaults.node.rocksdb_config.table_profiles);
+	ASSERT_NE (conf.node.rocksdb_config.unchecked_block_cache, defaults.node.rocksdb_config.unchecked_block_cache);
+	ASSERT_NE (conf.node.rocksdb_config.unchecked_ttl, defaults.node.rocksdb_config.unchecked_ttl);
 }
 
 /** There should be no required values **/
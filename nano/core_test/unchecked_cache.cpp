@@ -0,0 +1,74 @@
+#include <nano/core_test/testutil.hpp>
+#include <nano/node/testing.hpp>
+
+#include <gtest/gtest.h>
+
+TEST (unchecked_cache, spill)
+{
+	nano::system system (1);
+	auto & node (*system.nodes[0]);
+	nano::unchecked_cache cache (node.store, 2);
+	nano::keypair key;
+	auto block1 (std::make_shared<nano::send_block> (1, 1, 2, key.prv, key.pub, 5));
+	auto block2 (std::make_shared<nano::send_block> (1, 1, 3, key.prv, key.pub, 5));
+	auto block3 (std::make_shared<nano::send_block> (2, 1, 4, key.prv, key.pub, 5));
+	auto transaction (node.store.tx_begin_write ());
+	ASSERT_TRUE (cache.put (transaction, nano::unchecked_key (block1->previous (), block1->hash ()), nano::unchecked_info (block1, key.pub, 0)));
+	ASSERT_TRUE (cache.put (transaction, nano::unchecked_key (block2->previous (), block2->hash ()), nano::unchecked_info (block2, key.pub, 0)));
+	ASSERT_EQ (0, node.store.unchecked_count (transaction));
+	// Replacing an existing entry does not add a new one
+	ASSERT_FALSE (cache.put (transaction, nano::unchecked_key (block2->previous (), block2->hash ()), nano::unchecked_info (block2, key.pub, 1)));
+	ASSERT_EQ (2, cache.size ());
+	// Overflowing writes the oldest entry to the store
+	ASSERT_TRUE (cache.put (transaction, nano::unchecked_key (block3->previous (), block3->hash ()), nano::unchecked_info (block3, key.pub, 0)));
+	ASSERT_EQ (2, cache.size ());
+	ASSERT_EQ (1, node.store.unchecked_count (transaction));
+	ASSERT_TRUE (node.store.unchecked_exists (transaction, nano::unchecked_key (block1->previous (), block1->hash ())));
+	ASSERT_EQ (3, cache.count (transaction));
+	// Dependencies are found in both memory and the store
+	ASSERT_EQ (2, cache.get (transaction, block1->previous ()).size ());
+	ASSERT_FALSE (cache.put (transaction, nano::unchecked_key (block1->previous (), block1->hash ()), nano::unchecked_info (block1, key.pub, 0)));
+	ASSERT_EQ (3, cache.count (transaction));
+	ASSERT_FALSE (cache.del (transaction, nano::unchecked_key (block1->previous (), block1->hash ())));
+	ASSERT_FALSE (cache.del (transaction, nano::unchecked_key (block2->previous (), block2->hash ())));
+	ASSERT_TRUE (cache.del (transaction, nano::unchecked_key (block2->previous (), block2->hash ())));
+	ASSERT_EQ (1, cache.count (transaction));
+	cache.flush (transaction);
+	ASSERT_EQ (0, cache.size ());
+	ASSERT_EQ (1, node.store.unchecked_count (transaction));
+	ASSERT_EQ (1, cache.get (transaction, block3->previous ()).size ());
+}
+
+TEST (unchecked_cache, for_each_order)
+{
+	nano::system system (1);
+	auto & node (*system.nodes[0]);
+	nano::unchecked_cache cache (node.store, 2);
+	nano::keypair key;
+	std::vector<nano::unchecked_key> keys;
+	auto transaction (node.store.tx_begin_write ());
+	for (auto i (1); i <= 5; ++i)
+	{
+		auto block (std::make_shared<nano::send_block> (i, 1, i, key.prv, key.pub, 5));
+		nano::unchecked_key unchecked_key (block->previous (), block->hash ());
+		keys.push_back (unchecked_key);
+		cache.put (transaction, unchecked_key, nano::unchecked_info (block, key.pub, 0));
+	}
+	ASSERT_EQ (2, cache.size ());
+	ASSERT_EQ (3, node.store.unchecked_count (transaction));
+	std::vector<nano::unchecked_key> visited;
+	cache.for_each (transaction, [&visited](nano::unchecked_key const & key_a, nano::unchecked_info const &) {
+		visited.push_back (key_a);
+		return true;
+	});
+	ASSERT_EQ (keys, visited);
+	visited.clear ();
+	cache.for_each (transaction, [&visited](nano::unchecked_key const & key_a, nano::unchecked_info const &) {
+		visited.push_back (key_a);
+		return visited.size () < 2;
+	},
+	keys[2]);
+	ASSERT_EQ (2, visited.size ());
+	ASSERT_EQ (keys[2], visited[0]);
+	ASSERT_EQ (keys[3], visited[1]);
+}
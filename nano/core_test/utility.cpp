@@ -1,3 +1,5 @@
+#include <nano/boost/asio/post.hpp>
+#include <nano/lib/threading.hpp>
 #include <nano/lib/timer.hpp>
 #include <nano/lib/utility.hpp>
 #include <nano/lib/worker.hpp>
@@ -32,6 +34,25 @@ TEST (thread, worker)
 	ASSERT_TRUE (passed_sleep);
 }
 
+TEST (thread, pool_role)
+{
+	unsigned const num_threads (4);
+	boost::asio::thread_pool pool (num_threads);
+	nano::thread_role::set (pool, num_threads, nano::thread_role::name::worker);
+	std::atomic<unsigned> named{ 0 };
+	for (auto i (0u); i < 4 * num_threads; ++i)
+	{
+		boost::asio::post (pool, [&named]() {
+			if (nano::thread_role::get () == nano::thread_role::name::worker)
+			{
+				++named;
+			}
+		});
+	}
+	pool.join ();
+	ASSERT_EQ (4 * num_threads, named);
+}
+
 TEST (filesystem, remove_all_files)
 {
 	auto path = nano::unique_path ();
@@ -3,6 +3,8 @@
 #include <nano/boost/beast/core.hpp>
 #include <nano/boost/beast/websocket.hpp>
 #include <nano/core_test/testutil.hpp>
+#include <nano/lib/jsonconfig.hpp>
+#include <nano/lib/tomlconfig.hpp>
 #include <nano/node/testing.hpp>
 #include <nano/node/websocket.hpp>
 
@@ -75,6 +77,46 @@ boost::optional<std::string> websocket_test_call (std::string host, std::string
 	}
 	return ret;
 }
+
+using websocket_stream = boost::beast::websocket::stream<boost::asio::ip::tcp::socket>;
+
+/** Blocks until the next message arrives on \p ws_a and parses it */
+boost::property_tree::ptree websocket_read_json (websocket_stream & ws_a)
+{
+	boost::beast::flat_buffer buffer;
+	ws_a.read (buffer);
+	std::stringstream stream;
+	stream << beast_buffers (buffer.data ());
+	boost::property_tree::ptree event;
+	boost::property_tree::read_json (stream, event);
+	return event;
+}
+
+/** Connects and sends \p message_a, which must request an acknowledgement, then waits for it */
+std::shared_ptr<websocket_stream> websocket_acked_client (boost::asio::io_context & ioc_a, std::string port_a, std::string message_a)
+{
+	boost::asio::ip::tcp::resolver resolver{ ioc_a };
+	auto ws (std::make_shared<websocket_stream> (ioc_a));
+	auto const results = resolver.resolve ("::1", port_a);
+	boost::asio::connect (ws->next_layer (), results.begin (), results.end ());
+	ws->handshake ("::1", "/");
+	ws->text (true);
+	ws->write (boost::asio::buffer (message_a));
+	websocket_read_json (*ws);
+	return ws;
+}
+
+/** Subscribes to \p topic_a and waits for the acknowledgement. Nothing is read afterwards unless the caller does, so the server's writes stall once the socket buffers are full */
+std::shared_ptr<websocket_stream> websocket_stalled_client (boost::asio::io_context & ioc_a, std::string port_a, std::string topic_a)
+{
+	return websocket_acked_client (ioc_a, port_a, R"json({"action": "subscribe", "ack": true, "topic": ")json" + topic_a + R"json("})json");
+}
+
+/** A subscription to confirmations of blocks involving \p account_a only */
+std::string confirmation_subscription (nano::account const & account_a)
+{
+	return R"json({"action": "subscribe", "topic": "confirmation", "ack": true, "options": {"accounts": [")json" + account_a.to_account () + R"json("]}})json";
+}
 }
 
 /** Tests clients subscribing multiple times or unsubscribing without a subscription */
@@ -519,6 +561,201 @@ TEST (websocket, confirmation_options)
 	node1->stop ();
 }
 
+/** Account filters can be changed incrementally with update actions */
+TEST (websocket, confirmation_options_update)
+{
+	nano::system system (1);
+	auto & node1 (*system.nodes[0]);
+	auto accounts_tree = [](std::vector<nano::account> const & accounts_a) {
+		boost::property_tree::ptree tree;
+		for (auto const & account : accounts_a)
+		{
+			boost::property_tree::ptree entry;
+			entry.put ("", account.to_account ());
+			tree.push_back (std::make_pair ("", entry));
+		}
+		return tree;
+	};
+	boost::property_tree::ptree options_json;
+	options_json.add_child ("accounts", accounts_tree ({ nano::test_genesis_key.pub }));
+	nano::websocket::confirmation_options options (options_json, node1.wallets, node1.logger);
+	ASSERT_TRUE (options.filters_by_account_list ());
+	ASSERT_EQ (1, options.get_accounts ().size ());
+
+	nano::keypair key1;
+	nano::keypair key2;
+	nano::genesis genesis;
+	auto send (std::make_shared<nano::state_block> (nano::test_genesis_key.pub, genesis.hash (), nano::test_genesis_key.pub, nano::genesis_amount - 1, key1.pub, nano::test_genesis_key.prv, nano::test_genesis_key.pub, 0));
+	nano::election_status status{ send, 0, std::chrono::milliseconds (0), std::chrono::milliseconds (0), 0, 1, 0, nano::election_status_type::active_confirmed_quorum };
+	nano::websocket::message_builder builder;
+	auto message (builder.block_confirmed (send, nano::test_genesis_key.pub, 1, "send", true, status, options));
+	ASSERT_FALSE (options.should_filter (message));
+
+	// Replace the source account by the destination, the confirmation still passes
+	boost::property_tree::ptree update_json;
+	update_json.add_child ("accounts_add", accounts_tree ({ key1.pub, nano::test_genesis_key.pub }));
+	update_json.add_child ("accounts_del", accounts_tree ({ nano::test_genesis_key.pub, key2.pub }));
+	std::vector<nano::account> added;
+	std::vector<nano::account> removed;
+	options.update (update_json, node1.logger, added, removed);
+	ASSERT_EQ (std::vector<nano::account>{ key1.pub }, added);
+	ASSERT_EQ (std::vector<nano::account>{ nano::test_genesis_key.pub }, removed);
+	ASSERT_EQ (1, options.get_accounts ().count (key1.pub));
+	ASSERT_EQ (1, options.get_accounts ().size ());
+	ASSERT_FALSE (options.should_filter (message));
+
+	// Removing the last matching account filters the confirmation
+	boost::property_tree::ptree remove_json;
+	remove_json.add_child ("accounts_del", accounts_tree ({ key1.pub }));
+	added.clear ();
+	removed.clear ();
+	options.update (remove_json, node1.logger, added, removed);
+	ASSERT_TRUE (added.empty ());
+	ASSERT_EQ (std::vector<nano::account>{ key1.pub }, removed);
+	ASSERT_TRUE (options.get_accounts ().empty ());
+	ASSERT_TRUE (options.filters_by_account_list ());
+	ASSERT_TRUE (options.should_filter (message));
+}
+
+/** Sessions filtering by account are only sent confirmations of blocks involving their accounts */
+TEST (websocket, confirmation_accounts_filter)
+{
+	nano::system system;
+	nano::node_config config (nano::get_available_port (), system.logging);
+	config.websocket_config.enabled = true;
+	config.websocket_config.port = nano::get_available_port ();
+	auto node1 (system.add_node (config));
+	system.wallet (0)->insert_adhoc (nano::test_genesis_key.prv);
+	nano::keypair key1;
+	nano::keypair key2;
+
+	// Each client reads a single confirmation, which must be for its own account
+	auto client = [&config](nano::account const & account_a, std::atomic<bool> & received_a) {
+		boost::asio::io_context ioc;
+		auto ws (websocket_acked_client (ioc, std::to_string (config.websocket_config.port), confirmation_subscription (account_a)));
+		ack_ready = true;
+		auto event (websocket_read_json (*ws));
+		ASSERT_EQ ("confirmation", event.get<std::string> ("topic"));
+		ASSERT_EQ (account_a.to_account (), event.get<std::string> ("message.block.link_as_account"));
+		received_a = true;
+	};
+	ack_ready = false;
+	std::atomic<bool> client1_received{ false };
+	std::thread client1_thread ([&client, &key1, &client1_received]() { client (key1.pub, client1_received); });
+	system.deadline_set (5s);
+	while (!ack_ready)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	ack_ready = false;
+	std::atomic<bool> client2_received{ false };
+	std::thread client2_thread ([&client, &key2, &client2_received]() { client (key2.pub, client2_received); });
+	system.deadline_set (5s);
+	while (!ack_ready)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	ack_ready = false;
+	ASSERT_EQ (2, node1->websocket_server->subscriber_count (nano::websocket::topic::confirmation));
+
+	// The second client's first message would be this confirmation if it was not filtered
+	auto balance (nano::genesis_amount - 1);
+	nano::block_hash previous (node1->latest (nano::test_genesis_key.pub));
+	auto send1 (std::make_shared<nano::state_block> (nano::test_genesis_key.pub, previous, nano::test_genesis_key.pub, balance, key1.pub, nano::test_genesis_key.prv, nano::test_genesis_key.pub, *system.work.generate (previous)));
+	node1->process_active (send1);
+	system.deadline_set (5s);
+	while (!client1_received)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+
+	auto send2 (std::make_shared<nano::state_block> (nano::test_genesis_key.pub, send1->hash (), nano::test_genesis_key.pub, balance - 1, key2.pub, nano::test_genesis_key.prv, nano::test_genesis_key.pub, *system.work.generate (send1->hash ())));
+	node1->process_active (send2);
+	system.deadline_set (5s);
+	while (!client2_received)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+
+	client1_thread.join ();
+	client2_thread.join ();
+	node1->stop ();
+}
+
+/** Changing the accounts of a subscription with an update action changes which confirmations are sent */
+TEST (websocket, confirmation_accounts_update)
+{
+	nano::system system;
+	nano::node_config config (nano::get_available_port (), system.logging);
+	config.websocket_config.enabled = true;
+	config.websocket_config.port = nano::get_available_port ();
+	auto node1 (system.add_node (config));
+	system.wallet (0)->insert_adhoc (nano::test_genesis_key.prv);
+	nano::keypair key1;
+	nano::keypair key2;
+
+	// Both clients start filtering by key1, the first then moves to key2
+	ack_ready = false;
+	std::atomic<bool> client1_received{ false };
+	std::thread client1_thread ([&config, &key1, &key2, &client1_received]() {
+		boost::asio::io_context ioc;
+		auto ws (websocket_acked_client (ioc, std::to_string (config.websocket_config.port), confirmation_subscription (key1.pub)));
+		ws->write (boost::asio::buffer (R"json({"action": "update", "topic": "confirmation", "ack": true, "options": {"accounts_add": [")json" + key2.pub.to_account () + R"json("], "accounts_del": [")json" + key1.pub.to_account () + R"json("]}})json"));
+		auto ack (websocket_read_json (*ws));
+		ASSERT_EQ ("update", ack.get<std::string> ("ack"));
+		ack_ready = true;
+		auto event (websocket_read_json (*ws));
+		ASSERT_EQ (key2.pub.to_account (), event.get<std::string> ("message.block.link_as_account"));
+		client1_received = true;
+	});
+	system.deadline_set (5s);
+	while (!ack_ready)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	ack_ready = false;
+	std::atomic<bool> client2_received{ false };
+	std::thread client2_thread ([&config, &key1, &client2_received]() {
+		boost::asio::io_context ioc;
+		auto ws (websocket_acked_client (ioc, std::to_string (config.websocket_config.port), confirmation_subscription (key1.pub)));
+		ack_ready = true;
+		auto event (websocket_read_json (*ws));
+		ASSERT_EQ (key1.pub.to_account (), event.get<std::string> ("message.block.link_as_account"));
+		client2_received = true;
+	});
+	system.deadline_set (5s);
+	while (!ack_ready)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	ack_ready = false;
+
+	// Removing key1 from the first session must not affect the second one
+	auto balance (nano::genesis_amount - 1);
+	nano::block_hash previous (node1->latest (nano::test_genesis_key.pub));
+	auto send1 (std::make_shared<nano::state_block> (nano::test_genesis_key.pub, previous, nano::test_genesis_key.pub, balance, key1.pub, nano::test_genesis_key.prv, nano::test_genesis_key.pub, *system.work.generate (previous)));
+	node1->process_active (send1);
+	system.deadline_set (5s);
+	while (!client2_received)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	ASSERT_FALSE (client1_received);
+
+	// The first session's first message would have been the key1 confirmation if it was still subscribed to it
+	auto send2 (std::make_shared<nano::state_block> (nano::test_genesis_key.pub, send1->hash (), nano::test_genesis_key.pub, balance - 1, key2.pub, nano::test_genesis_key.prv, nano::test_genesis_key.pub, *system.work.generate (send1->hash ())));
+	node1->process_active (send2);
+	system.deadline_set (5s);
+	while (!client1_received)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+
+	client1_thread.join ();
+	client2_thread.join ();
+	node1->stop ();
+}
+
 /** Subscribes to votes, sends a block and awaits websocket notification of a vote arrival */
 TEST (websocket, vote)
 {
@@ -639,6 +876,69 @@ TEST (websocket, vote_options_type)
 	node1->stop ();
 }
 
+/** Tests that replayed votes are still verified and broadcast while there is a vote subscriber */
+TEST (websocket, vote_replay)
+{
+	nano::system system;
+	nano::node_config config (nano::get_available_port (), system.logging);
+	config.websocket_config.enabled = true;
+	config.websocket_config.port = nano::get_available_port ();
+	config.online_weight_minimum = std::numeric_limits<nano::uint128_t>::max ();
+	config.frontiers_confirmation = nano::frontiers_confirmation_mode::disabled;
+	auto node1 (system.add_node (config));
+
+	// Start an election which cannot be confirmed and count a first vote for it
+	nano::genesis genesis;
+	nano::keypair key;
+	auto send1 (std::make_shared<nano::state_block> (nano::test_genesis_key.pub, genesis.hash (), nano::test_genesis_key.pub, nano::genesis_amount - nano::Gxrb_ratio, key.pub, nano::test_genesis_key.prv, nano::test_genesis_key.pub, *system.work.generate (genesis.hash ())));
+	node1->process_active (send1);
+	node1->block_processor.flush ();
+	ASSERT_EQ (1, node1->active.size ());
+	auto channel (std::make_shared<nano::transport::channel_udp> (node1->network.udp_channels, node1->network.endpoint (), node1->network_params.protocol.protocol_version));
+	auto vote (std::make_shared<nano::vote> (nano::test_genesis_key.pub, nano::test_genesis_key.prv, 1, send1));
+	node1->vote_processor.vote (vote, channel);
+	node1->vote_processor.flush ();
+	ASSERT_EQ (1, node1->stats.count (nano::stat::type::vote, nano::stat::detail::vote_valid));
+
+	// Subscribe to replays and wait for the replayed vote asynchronously
+	ack_ready = false;
+	std::atomic<bool> replay_received{ false };
+	std::thread client_thread ([&replay_received, config]() {
+		auto response = websocket_test_call ("::1", std::to_string (config.websocket_config.port),
+		R"json({"action": "subscribe", "topic": "vote", "ack": true, "options": {"include_replays": "true"}})json", true, true);
+		ASSERT_TRUE (response);
+		boost::property_tree::ptree event;
+		std::stringstream stream;
+		stream << response;
+		boost::property_tree::read_json (stream, event);
+		auto message_contents = event.get_child ("message");
+		ASSERT_EQ ("replay", message_contents.get<std::string> ("type"));
+		ASSERT_EQ (nano::test_genesis_key.pub.to_account (), message_contents.get<std::string> ("account"));
+		replay_received = true;
+	});
+
+	system.deadline_set (5s);
+	while (!ack_ready)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	ASSERT_EQ (1, node1->websocket_server->subscriber_count (nano::websocket::topic::vote));
+
+	// The replay is not filtered before signature checking, so it reaches the observers
+	node1->vote_processor.vote (vote, channel);
+	node1->vote_processor.flush ();
+	ASSERT_EQ (0, node1->stats.count (nano::stat::type::vote, nano::stat::detail::vote_filtered_replay));
+	ASSERT_EQ (1, node1->stats.count (nano::stat::type::vote, nano::stat::detail::vote_replay));
+
+	system.deadline_set (5s);
+	while (!replay_received)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	client_thread.join ();
+	node1->stop ();
+}
+
 /** Tests vote subscription options - list of representatives */
 TEST (websocket, vote_options_representatives)
 {
@@ -955,3 +1255,116 @@ TEST (websocket, ws_keepalive)
 	}
 	subscription_thread.join ();
 }
+
+/** Config deserialization rejects an empty send queue */
+TEST (websocket, config_send_queue_max)
+{
+	nano::websocket::config defaults;
+	nano::jsonconfig json;
+	defaults.serialize_json (json);
+	json.put ("send_queue_max", 0);
+	nano::websocket::config config_json;
+	ASSERT_TRUE (config_json.deserialize_json (json));
+
+	nano::tomlconfig toml;
+	defaults.serialize_toml (toml);
+	toml.put ("send_queue_max", 0);
+	nano::websocket::config config_toml;
+	ASSERT_TRUE (config_toml.deserialize_toml (toml));
+}
+
+/** A session which stops reading has messages dropped once its send queue is full, but stays connected */
+TEST (websocket, send_queue_drop)
+{
+	nano::system system;
+	nano::node_config config (nano::get_available_port (), system.logging);
+	config.websocket_config.enabled = true;
+	config.websocket_config.port = nano::get_available_port ();
+	config.websocket_config.send_queue_max = 2;
+	config.websocket_config.overflow_policy = nano::websocket::overflow_policy::drop;
+	auto node1 (system.add_node (config));
+
+	boost::asio::io_context ioc;
+	std::shared_ptr<websocket_stream> ws;
+	std::atomic<bool> subscribed{ false };
+	std::thread client_thread ([&ioc, &ws, &subscribed, config]() {
+		ws = websocket_stalled_client (ioc, std::to_string (config.websocket_config.port), "work");
+		subscribed = true;
+	});
+	system.deadline_set (5s);
+	while (!subscribed)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	client_thread.join ();
+
+	// Large messages fill the socket buffers quickly
+	nano::websocket::message message (nano::websocket::topic::work);
+	message.contents.put ("payload", std::string (1024 * 1024, 'x'));
+	system.deadline_set (10s);
+	while (node1->stats.count (nano::stat::type::websocket, nano::stat::detail::message_drop, nano::stat::dir::out) == 0)
+	{
+		node1->websocket_server->broadcast (message);
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	ASSERT_EQ (0, node1->stats.count (nano::stat::type::websocket, nano::stat::detail::session_overflow, nano::stat::dir::out));
+	ASSERT_EQ (1, node1->websocket_server->subscriber_count (nano::websocket::topic::work));
+	node1->stop ();
+}
+
+/** A session which stops reading is closed once its send queue is full under the disconnect policy */
+TEST (websocket, send_queue_disconnect)
+{
+	nano::system system;
+	nano::node_config config (nano::get_available_port (), system.logging);
+	config.websocket_config.enabled = true;
+	config.websocket_config.port = nano::get_available_port ();
+	config.websocket_config.send_queue_max = 2;
+	config.websocket_config.overflow_policy = nano::websocket::overflow_policy::disconnect;
+	auto node1 (system.add_node (config));
+
+	boost::asio::io_context ioc;
+	std::shared_ptr<websocket_stream> ws;
+	std::atomic<bool> subscribed{ false };
+	std::thread client_thread ([&ioc, &ws, &subscribed, config]() {
+		ws = websocket_stalled_client (ioc, std::to_string (config.websocket_config.port), "work");
+		subscribed = true;
+	});
+	system.deadline_set (5s);
+	while (!subscribed)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	client_thread.join ();
+
+	nano::websocket::message message (nano::websocket::topic::work);
+	message.contents.put ("payload", std::string (1024 * 1024, 'x'));
+	system.deadline_set (10s);
+	while (node1->stats.count (nano::stat::type::websocket, nano::stat::detail::session_overflow, nano::stat::dir::out) == 0)
+	{
+		node1->websocket_server->broadcast (message);
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	ASSERT_LE (1, node1->stats.count (nano::stat::type::websocket, nano::stat::detail::message_drop, nano::stat::dir::out));
+
+	// Reading what was sent ends with an error once the server has closed the socket
+	std::atomic<bool> closed{ false };
+	std::thread reader_thread ([ws, &closed]() {
+		boost::beast::flat_buffer buffer;
+		boost::system::error_code ec;
+		while (!ec)
+		{
+			buffer.consume (buffer.size ());
+			ws->read (buffer, ec);
+		}
+		closed = true;
+	});
+	system.deadline_set (10s);
+	while (!closed || node1->websocket_server->subscriber_count (nano::websocket::topic::work) != 0)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	reader_thread.join ();
+	ASSERT_EQ (1, node1->stats.count (nano::stat::type::websocket, nano::stat::detail::session_overflow, nano::stat::dir::out));
+	node1->stop ();
+}
@@ -659,6 +659,7 @@ std::unique_ptr<BLOCKTYPE> nano::abstract_builder<BLOCKTYPE, BUILDER>::build ()
 		static_cast<BUILDER *> (this)->validate ();
 	}
 	assert (!ec);
+	block->refresh ();
 	return std::move (block);
 }
 
@@ -670,6 +671,7 @@ std::unique_ptr<BLOCKTYPE> nano::abstract_builder<BLOCKTYPE, BUILDER>::build (st
 		static_cast<BUILDER *> (this)->validate ();
 	}
 	ec = this->ec;
+	block->refresh ();
 	return std::move (block);
 }
 
@@ -684,6 +686,7 @@ nano::abstract_builder<BLOCKTYPE, BUILDER> & nano::abstract_builder<BLOCKTYPE, B
 template <typename BLOCKTYPE, typename BUILDER>
 nano::abstract_builder<BLOCKTYPE, BUILDER> & nano::abstract_builder<BLOCKTYPE, BUILDER>::sign (nano::raw_key const & private_key, nano::public_key const & public_key)
 {
+	block->refresh ();
 	block->signature = nano::sign_message (private_key, public_key, block->hash ());
 	build_state |= build_flags::signature_present;
 	return *this;
@@ -7,8 +7,12 @@
 #include <crypto/cryptopp/words.h>
 
 #include <boost/endian/conversion.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/stream_buffer.hpp>
 #include <boost/property_tree/json_parser.hpp>
 
+#include <cstring>
+
 /** Compare blocks, first by type, then content. This is an optimization over dynamic_cast, which is very slow on some platforms. */
 namespace
 {
@@ -76,7 +80,48 @@ size_t nano::block::size (nano::block_type type_a)
 	return result;
 }
 
+nano::block::block (nano::block const & other_a)
+{
+	*this = other_a;
+}
+
+nano::block & nano::block::operator= (nano::block const & other_a)
+{
+	if (other_a.cached_hash_state.load (std::memory_order_acquire) == hash_state::ready)
+	{
+		cached_hash = other_a.cached_hash;
+		cached_hash_state.store (hash_state::ready, std::memory_order_release);
+	}
+	else
+	{
+		cached_hash_state.store (hash_state::empty, std::memory_order_release);
+	}
+	return *this;
+}
+
 nano::block_hash nano::block::hash () const
+{
+	if (cached_hash_state.load (std::memory_order_acquire) == hash_state::ready)
+	{
+		return cached_hash;
+	}
+	auto result (generate_hash ());
+	// Concurrent readers may all generate the hash, only the one which claims the cache writes it
+	auto expected (hash_state::empty);
+	if (cached_hash_state.compare_exchange_strong (expected, hash_state::writing, std::memory_order_acquire))
+	{
+		cached_hash = result;
+		cached_hash_state.store (hash_state::ready, std::memory_order_release);
+	}
+	return result;
+}
+
+void nano::block::refresh ()
+{
+	cached_hash_state.store (hash_state::empty, std::memory_order_release);
+}
+
+nano::block_hash nano::block::generate_hash () const
 {
 	nano::block_hash result;
 	blake2b_state hash_l;
@@ -93,7 +138,8 @@ nano::block_hash nano::block::full_hash () const
 	nano::block_hash result;
 	blake2b_state state;
 	blake2b_init (&state, sizeof (result.bytes));
-	blake2b_update (&state, hash ().bytes.data (), sizeof (hash ()));
+	auto hash_l (hash ());
+	blake2b_update (&state, hash_l.bytes.data (), sizeof (hash_l));
 	auto signature (block_signature ());
 	blake2b_update (&state, signature.bytes.data (), sizeof (signature));
 	auto work (block_work ());
@@ -102,6 +148,34 @@ nano::block_hash nano::block::full_hash () const
 	return result;
 }
 
+void nano::serialized_block_hashes (nano::block_type type_a, uint8_t const * data_a, nano::block_hash & hash_a, nano::block_hash & full_hash_a)
+{
+	// Every block serializes as its hashables followed by the signature and work
+	auto size (nano::block::size (type_a));
+	auto hashables_size (size - sizeof (nano::signature) - sizeof (uint64_t));
+	blake2b_state hash;
+	blake2b_init (&hash, sizeof (hash_a.bytes));
+	if (type_a == nano::block_type::state)
+	{
+		nano::uint256_union preamble (static_cast<uint64_t> (nano::block_type::state));
+		blake2b_update (&hash, preamble.bytes.data (), preamble.bytes.size ());
+	}
+	blake2b_update (&hash, data_a, hashables_size);
+	blake2b_final (&hash, hash_a.bytes.data (), sizeof (hash_a.bytes));
+	uint64_t work;
+	std::memcpy (&work, data_a + hashables_size + sizeof (nano::signature), sizeof (work));
+	if (type_a == nano::block_type::state)
+	{
+		boost::endian::big_to_native_inplace (work);
+	}
+	blake2b_state full_hash;
+	blake2b_init (&full_hash, sizeof (full_hash_a.bytes));
+	blake2b_update (&full_hash, hash_a.bytes.data (), sizeof (hash_a.bytes));
+	blake2b_update (&full_hash, data_a + hashables_size, sizeof (nano::signature));
+	blake2b_update (&full_hash, &work, sizeof (work));
+	blake2b_final (&full_hash, full_hash_a.bytes.data (), sizeof (full_hash_a.bytes));
+}
+
 nano::account const & nano::block::representative () const
 {
 	static nano::account rep{ 0 };
@@ -236,6 +310,7 @@ bool nano::send_block::deserialize (nano::stream & stream_a)
 		error = true;
 	}
 
+	refresh ();
 	return error;
 }
 
@@ -297,6 +372,7 @@ bool nano::send_block::deserialize_json (boost::property_tree::ptree const & tre
 	{
 		error = true;
 	}
+	refresh ();
 	return error;
 }
 
@@ -561,6 +637,7 @@ bool nano::open_block::deserialize (nano::stream & stream_a)
 		error = true;
 	}
 
+	refresh ();
 	return error;
 }
 
@@ -618,6 +695,7 @@ bool nano::open_block::deserialize_json (boost::property_tree::ptree const & tre
 	{
 		error = true;
 	}
+	refresh ();
 	return error;
 }
 
@@ -803,6 +881,7 @@ bool nano::change_block::deserialize (nano::stream & stream_a)
 		error = true;
 	}
 
+	refresh ();
 	return error;
 }
 
@@ -854,6 +933,7 @@ bool nano::change_block::deserialize_json (boost::property_tree::ptree const & t
 	{
 		error = true;
 	}
+	refresh ();
 	return error;
 }
 
@@ -1091,6 +1171,7 @@ bool nano::state_block::deserialize (nano::stream & stream_a)
 		error = true;
 	}
 
+	refresh ();
 	return error;
 }
 
@@ -1161,6 +1242,7 @@ bool nano::state_block::deserialize_json (boost::property_tree::ptree const & tr
 	{
 		error = true;
 	}
+	refresh ();
 	return error;
 }
 
@@ -1285,40 +1367,63 @@ std::shared_ptr<nano::block> nano::deserialize_block (nano::stream & stream_a)
 std::shared_ptr<nano::block> nano::deserialize_block (nano::stream & stream_a, nano::block_type type_a, nano::block_uniquer * uniquer_a)
 {
 	std::shared_ptr<nano::block> result;
-	switch (type_a)
-	{
-		case nano::block_type::receive:
+	auto is_block (type_a == nano::block_type::send || type_a == nano::block_type::receive || type_a == nano::block_type::open || type_a == nano::block_type::change || type_a == nano::block_type::state);
+	if (uniquer_a != nullptr && is_block)
+	{
+		// Hash the raw bytes first so duplicates, e.g. republished blocks, never allocate
+		std::array<uint8_t, nano::state_block::size> buffer;
+		auto size (nano::block::size (type_a));
+		assert (size <= buffer.size ());
+		if (static_cast<size_t> (stream_a.sgetn (buffer.data (), size)) == size)
 		{
-			result = ::deserialize_block<nano::receive_block> (stream_a);
-			break;
-		}
-		case nano::block_type::send:
-		{
-			result = ::deserialize_block<nano::send_block> (stream_a);
-			break;
-		}
-		case nano::block_type::open:
-		{
-			result = ::deserialize_block<nano::open_block> (stream_a);
-			break;
+			nano::block_hash hash;
+			nano::block_hash full_hash;
+			nano::serialized_block_hashes (type_a, buffer.data (), hash, full_hash);
+			result = uniquer_a->find (full_hash);
+			if (result == nullptr)
+			{
+				boost::iostreams::stream_buffer<boost::iostreams::basic_array_source<uint8_t>> block_stream (buffer.data (), size);
+				result = uniquer_a->unique (nano::deserialize_block (block_stream, type_a));
+			}
 		}
-		case nano::block_type::change:
+	}
+	else
+	{
+		switch (type_a)
 		{
-			result = ::deserialize_block<nano::change_block> (stream_a);
-			break;
+			case nano::block_type::receive:
+			{
+				result = ::deserialize_block<nano::receive_block> (stream_a);
+				break;
+			}
+			case nano::block_type::send:
+			{
+				result = ::deserialize_block<nano::send_block> (stream_a);
+				break;
+			}
+			case nano::block_type::open:
+			{
+				result = ::deserialize_block<nano::open_block> (stream_a);
+				break;
+			}
+			case nano::block_type::change:
+			{
+				result = ::deserialize_block<nano::change_block> (stream_a);
+				break;
+			}
+			case nano::block_type::state:
+			{
+				result = ::deserialize_block<nano::state_block> (stream_a);
+				break;
+			}
+			default:
+				assert (false);
+				break;
 		}
-		case nano::block_type::state:
+		if (uniquer_a != nullptr)
 		{
-			result = ::deserialize_block<nano::state_block> (stream_a);
-			break;
+			result = uniquer_a->unique (result);
 		}
-		default:
-			assert (false);
-			break;
-	}
-	if (uniquer_a != nullptr)
-	{
-		result = uniquer_a->unique (result);
 	}
 	return result;
 }
@@ -1357,6 +1462,7 @@ bool nano::receive_block::deserialize (nano::stream & stream_a)
 		error = true;
 	}
 
+	refresh ();
 	return error;
 }
 
@@ -1412,6 +1518,7 @@ bool nano::receive_block::deserialize_json (boost::property_tree::ptree const &
 	{
 		error = true;
 	}
+	refresh ();
 	return error;
 }
 
@@ -1613,6 +1720,18 @@ std::shared_ptr<nano::block> nano::block_uniquer::unique (std::shared_ptr<nano::
 	return result;
 }
 
+std::shared_ptr<nano::block> nano::block_uniquer::find (nano::uint256_union const & full_hash_a)
+{
+	std::shared_ptr<nano::block> result;
+	nano::lock_guard<std::mutex> lock (mutex);
+	auto existing (blocks.find (full_hash_a));
+	if (existing != blocks.end ())
+	{
+		result = existing->second.lock ();
+	}
+	return result;
+}
+
 size_t nano::block_uniquer::size ()
 {
 	nano::lock_guard<std::mutex> lock (mutex);
@@ -7,6 +7,7 @@
 
 #include <boost/property_tree/ptree_fwd.hpp>
 
+#include <atomic>
 #include <cassert>
 #include <streambuf>
 #include <unordered_map>
@@ -56,7 +57,7 @@ enum class block_type : uint8_t
 class block
 {
 public:
-	// Return a digest of the hashables in this block.
+	// Return a digest of the hashables in this block. The digest is computed once and cached until refresh () is called.
 	nano::block_hash hash () const;
 	// Return a digest of hashables and non-hashables in this block.
 	nano::block_hash full_hash () const;
@@ -87,7 +88,26 @@ public:
 	virtual void signature_set (nano::signature const &) = 0;
 	virtual ~block () = default;
 	virtual bool valid_predecessor (nano::block const &) const = 0;
+	// Discard the cached hash, must be called after modifying hashables directly
+	void refresh ();
 	static size_t size (nano::block_type);
+
+protected:
+	block () = default;
+	block (nano::block const &);
+	nano::block & operator= (nano::block const &);
+	nano::block_hash generate_hash () const;
+
+private:
+	enum class hash_state : uint8_t
+	{
+		empty,
+		writing,
+		ready
+	};
+	// cached_hash is written once by the first thread to claim it and only read after it is published as ready
+	mutable std::atomic<hash_state> cached_hash_state{ hash_state::empty };
+	mutable nano::block_hash cached_hash{ 0 };
 };
 class send_hashables
 {
@@ -349,6 +369,8 @@ public:
 	using value_type = std::pair<const nano::uint256_union, std::weak_ptr<nano::block>>;
 
 	std::shared_ptr<nano::block> unique (std::shared_ptr<nano::block>);
+	/** Returns the live block with this full hash, or nullptr */
+	std::shared_ptr<nano::block> find (nano::uint256_union const &);
 	size_t size ();
 
 private:
@@ -360,7 +382,10 @@ private:
 std::unique_ptr<container_info_component> collect_container_info (block_uniquer & block_uniquer, const std::string & name);
 
 std::shared_ptr<nano::block> deserialize_block (nano::stream &);
+/** When a uniquer is supplied, blocks already held by it are returned without being deserialized */
 std::shared_ptr<nano::block> deserialize_block (nano::stream &, nano::block_type, nano::block_uniquer * = nullptr);
+/** Computes block::hash () and block::full_hash () over the block::size (type) serialized bytes at \p data_a */
+void serialized_block_hashes (nano::block_type, uint8_t const * data_a, nano::block_hash &, nano::block_hash &);
 std::shared_ptr<nano::block> deserialize_block_json (boost::property_tree::ptree const &, nano::block_uniquer * = nullptr);
 void serialize_block (nano::stream &, nano::block const &);
 void block_memory_pool_purge ();
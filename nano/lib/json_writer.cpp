@@ -0,0 +1,148 @@
+#include <nano/lib/json_writer.hpp>
+
+#include <boost/property_tree/ptree.hpp>
+
+#include <cassert>
+#include <cstdio>
+
+nano::json_writer::json_writer ()
+{
+	stack.push_back (container{ false, false });
+}
+
+void nano::json_writer::begin_object (std::string const & key_a)
+{
+	key (key_a);
+	stack.push_back (container{ false, false });
+}
+
+void nano::json_writer::begin_array (std::string const & key_a)
+{
+	key (key_a);
+	stack.push_back (container{ true, false });
+}
+
+void nano::json_writer::end ()
+{
+	assert (!stack.empty ());
+	auto const & back (stack.back ());
+	if (back.opened)
+	{
+		output.push_back (back.array ? ']' : '}');
+	}
+	else
+	{
+		// Same as write_json for a node without children
+		output.append ("\"\"");
+	}
+	stack.pop_back ();
+}
+
+void nano::json_writer::put (std::string const & key_a, std::string const & value_a)
+{
+	key (key_a);
+	value (value_a);
+}
+
+void nano::json_writer::put_tree (std::string const & key_a, boost::property_tree::ptree const & tree_a)
+{
+	key (key_a);
+	tree (tree_a);
+}
+
+std::string nano::json_writer::str ()
+{
+	while (!stack.empty ())
+	{
+		end ();
+	}
+	return std::move (output);
+}
+
+void nano::json_writer::key (std::string const & key_a)
+{
+	assert (!stack.empty ());
+	auto & back (stack.back ());
+	if (!back.opened)
+	{
+		output.push_back (back.array ? '[' : '{');
+		back.opened = true;
+	}
+	else
+	{
+		output.push_back (',');
+	}
+	if (!back.array)
+	{
+		value (key_a);
+		output.push_back (':');
+	}
+}
+
+void nano::json_writer::value (std::string const & value_a)
+{
+	// Escapes the same characters as write_json
+	output.push_back ('"');
+	for (auto c : value_a)
+	{
+		switch (c)
+		{
+			case '"':
+				output.append ("\\\"");
+				break;
+			case '\\':
+				output.append ("\\\\");
+				break;
+			case '/':
+				output.append ("\\/");
+				break;
+			case '\b':
+				output.append ("\\b");
+				break;
+			case '\f':
+				output.append ("\\f");
+				break;
+			case '\n':
+				output.append ("\\n");
+				break;
+			case '\r':
+				output.append ("\\r");
+				break;
+			case '\t':
+				output.append ("\\t");
+				break;
+			default:
+				if (static_cast<unsigned char> (c) < 0x20)
+				{
+					char escaped[7];
+					std::snprintf (escaped, sizeof (escaped), "\\u%04x", static_cast<unsigned> (c));
+					output.append (escaped);
+				}
+				else
+				{
+					output.push_back (c);
+				}
+				break;
+		}
+	}
+	output.push_back ('"');
+}
+
+void nano::json_writer::tree (boost::property_tree::ptree const & tree_a)
+{
+	if (tree_a.empty ())
+	{
+		value (tree_a.data ());
+	}
+	else
+	{
+		auto array (tree_a.count ("") == tree_a.size ());
+		stack.push_back (container{ array, false });
+		for (auto const & child : tree_a)
+		{
+			key (child.first);
+			tree (child.second);
+		}
+		end ();
+	}
+}
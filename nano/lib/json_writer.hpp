@@ -0,0 +1,42 @@
+#pragma once
+
+#include <boost/property_tree/ptree_fwd.hpp>
+
+#include <string>
+#include <vector>
+
+namespace nano
+{
+/**
+ * Writes compact JSON directly into a string, for responses which are too large to build as a property tree first.
+ * Output is compatible with boost::property_tree::write_json: every value is a string, and containers without
+ * children are written as an empty string. The writer starts inside the root object.
+ */
+class json_writer final
+{
+public:
+	json_writer ();
+	/** Keys are ignored inside arrays */
+	void begin_object (std::string const & key_a = "");
+	void begin_array (std::string const & key_a = "");
+	/** Closes the innermost object or array */
+	void end ();
+	void put (std::string const & key_a, std::string const & value_a);
+	void put_tree (std::string const & key_a, boost::property_tree::ptree const & tree_a);
+	/** Closes any open containers and returns the document */
+	std::string str ();
+
+private:
+	class container final
+	{
+	public:
+		bool array;
+		bool opened;
+	};
+	void key (std::string const & key_a);
+	void value (std::string const & value_a);
+	void tree (boost::property_tree::ptree const & tree_a);
+	std::vector<container> stack;
+	std::string output;
+};
+}
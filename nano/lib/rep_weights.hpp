@@ -3,6 +3,7 @@
 #include <nano/lib/numbers.hpp>
 #include <nano/lib/utility.hpp>
 
+#include <array>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
@@ -12,6 +13,10 @@ namespace nano
 class block_store;
 class transaction;
 
+/**
+ * Representative weight table, partitioned into independently locked shards
+ * keyed by representative so that vote tallying rarely contends with ledger writes.
+ */
 class rep_weights
 {
 public:
@@ -19,12 +24,22 @@ public:
 	nano::uint128_t representation_get (nano::account const & account_a);
 	void representation_put (nano::account const & account_a, nano::uint128_union const & representation_a);
 	std::unordered_map<nano::account, nano::uint128_t> get_rep_amounts ();
+	size_t size ();
+	static size_t constexpr shard_count = 16;
 
 private:
-	std::mutex mutex;
-	std::unordered_map<nano::account, nano::uint128_t> rep_amounts;
-	void put (nano::account const & account_a, nano::uint128_union const & representation_a);
-	nano::uint128_t get (nano::account const & account_a);
+	class shard final
+	{
+	public:
+		std::mutex mutex;
+		std::unordered_map<nano::account, nano::uint128_t> rep_amounts;
+		// Keeps the next shard's mutex off this shard's cache lines. alignas would need over-aligned allocation, which C++14 doesn't provide
+		char padding[64];
+	};
+	std::array<shard, shard_count> shards;
+	shard & shard_for (nano::account const & account_a);
+	void put (shard &, nano::account const & account_a, nano::uint128_union const & representation_a);
+	nano::uint128_t get (shard &, nano::account const & account_a);
 
 	friend std::unique_ptr<container_info_component> collect_container_info (rep_weights &, const std::string &);
 };
@@ -13,6 +13,9 @@ nano::error nano::rocksdb_config::serialize_toml (nano::tomlconfig & toml) const
 	toml.put ("num_memtables", num_memtables, "Number of memtables to keep in memory per column family. 2 is the minimum, 3 is recommended.\ntype:uint32");
 	toml.put ("memtable_size", memtable_size, "Amount of memory (MB) to build up before flushing to disk for an individual column family. Large values increase performance. 64 or 128 is recommended.\ntype:uint32");
 	toml.put ("total_memtable_size", total_memtable_size, "Total memory (MB) which can be used across all memtables, set to 0 for unconstrained.\ntype:uint32");
+	toml.put ("table_profiles", table_profiles, "Whether to tune each column family for its access pattern: bloom filters only for tables with point lookups, a fixed account/hash prefix for pending and unchecked, and a separate block cache for unchecked. When false every table uses the same options.\ntype:bool");
+	toml.put ("unchecked_block_cache", unchecked_block_cache, "Size (MB) of the block cache used by the unchecked table when table_profiles is enabled.\ntype:uint64");
+	toml.put ("unchecked_ttl", unchecked_ttl, "Age (seconds) after which unchecked table files are compacted to discard deleted entries when table_profiles is enabled.\ntype:uint32");
 	return toml.get_error ();
 }
 
@@ -28,6 +31,9 @@ nano::error nano::rocksdb_config::deserialize_toml (nano::tomlconfig & toml)
 	toml.get_optional<unsigned> ("num_memtables", num_memtables);
 	toml.get_optional<unsigned> ("memtable_size", memtable_size);
 	toml.get_optional<unsigned> ("total_memtable_size", total_memtable_size);
+	toml.get_optional<bool> ("table_profiles", table_profiles);
+	toml.get_optional<uint64_t> ("unchecked_block_cache", unchecked_block_cache);
+	toml.get_optional<unsigned> ("unchecked_ttl", unchecked_ttl);
 
 	// Validate ranges
 	if (bloom_filter_bits > 100)
@@ -54,6 +60,10 @@ nano::error nano::rocksdb_config::deserialize_toml (nano::tomlconfig & toml)
 	{
 		toml.get_error ().set ("block_size must be non-zero");
 	}
+	if (unchecked_ttl == 0)
+	{
+		toml.get_error ().set ("unchecked_ttl must be non-zero");
+	}
 
 	return toml.get_error ();
 }
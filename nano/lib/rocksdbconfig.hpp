@@ -25,5 +25,8 @@ public:
 	unsigned memtable_size{ 32 }; // MB
 	unsigned num_memtables{ 2 }; // Need a minimum of 2
 	unsigned total_memtable_size{ 512 }; // MB
+	bool table_profiles{ true };
+	uint64_t unchecked_block_cache{ 16 }; // MB
+	unsigned unchecked_ttl{ 60 * 60 }; // Seconds
 };
 }
@@ -192,10 +192,107 @@ public:
 };
 
 nano::stat::stat (nano::stat_config config) :
-config (config)
+config (config),
+fast_counters (!config.sampling_enabled && config.log_interval_counters == 0)
 {
 }
 
+nano::stat::~stat ()
+{
+	for (auto & shard : shards)
+	{
+		delete shard.load ();
+	}
+}
+
+size_t nano::stat::counter_slot (uint32_t key_a)
+{
+	auto type (key_a >> 16 & 0xff);
+	auto detail (key_a >> 8 & 0xff);
+	auto dir (key_a & 0xff);
+	size_t result (counter_slots);
+	if (type < 32 && detail < 128 && dir < 2)
+	{
+		result = (type * 128 + detail) * 2 + dir;
+	}
+	return result;
+}
+
+bool nano::stat::counter_add (uint32_t key_a, uint64_t value_a)
+{
+	auto result (false);
+	auto slot (counter_slot (key_a));
+	if (fast_counters && slot < counter_slots && !stopped)
+	{
+		auto state (slot_states[slot].load ());
+		if (state == slot_state::unregistered)
+		{
+			// Create the entry once so the counter is listed when logging
+			nano::lock_guard<std::mutex> lock (stat_mutex);
+			get_entry_impl (key_a, config.interval, config.capacity);
+			uint8_t expected (slot_state::unregistered);
+			slot_states[slot].compare_exchange_strong (expected, slot_state::registered);
+			state = slot_states[slot].load ();
+		}
+		if (state == slot_state::registered)
+		{
+			static std::atomic<unsigned> next_shard{ 0 };
+			static thread_local unsigned const shard_index (next_shard++ % counter_shards);
+			auto & shard_pointer (shards[shard_index]);
+			auto shard (shard_pointer.load (std::memory_order_acquire));
+			if (shard == nullptr)
+			{
+				auto allocated (new counter_shard ());
+				if (shard_pointer.compare_exchange_strong (shard, allocated, std::memory_order_acq_rel))
+				{
+					shard = allocated;
+				}
+				else
+				{
+					// Another thread mapped to this shard allocated it first
+					delete allocated;
+				}
+			}
+			shard->values[slot].fetch_add (value_a, std::memory_order_relaxed);
+			result = true;
+		}
+	}
+	return result;
+}
+
+uint64_t nano::stat::counter_sum (size_t slot_a) const
+{
+	uint64_t result (0);
+	if (slot_a < counter_slots)
+	{
+		for (auto const & shard_pointer : shards)
+		{
+			if (auto shard = shard_pointer.load (std::memory_order_acquire))
+			{
+				result += shard->values[slot_a].load (std::memory_order_relaxed);
+			}
+		}
+	}
+	return result;
+}
+
+uint64_t nano::stat::count (stat::type type, stat::detail detail, stat::dir dir)
+{
+	auto key (key_of (type, detail, dir));
+	return get_entry (key)->counter.get_value () + counter_sum (counter_slot (key));
+}
+
+void nano::stat::observe_count (stat::type type, stat::detail detail, stat::dir dir, std::function<void(uint64_t, uint64_t)> observer)
+{
+	auto key (key_of (type, detail, dir));
+	auto slot (counter_slot (key));
+	if (slot < counter_slots)
+	{
+		slot_states[slot] = slot_state::observed;
+	}
+	get_entry (key)->count_observers.add (observer);
+}
+
 std::shared_ptr<nano::stat_entry> nano::stat::get_entry (uint32_t key)
 {
 	return get_entry (key, config.interval, config.capacity);
@@ -257,7 +354,7 @@ void nano::stat::log_counters_impl (stat_log_sink & sink)
 		std::string type = type_to_string (key);
 		std::string detail = detail_to_string (key);
 		std::string dir = dir_to_string (key);
-		sink.write_entry (local_tm, type, detail, dir, it.second->counter.get_value ());
+		sink.write_entry (local_tm, type, detail, dir, it.second->counter.get_value () + counter_sum (counter_slot (key)));
 	}
 	sink.entries ()++;
 	sink.finalize ();
@@ -303,6 +400,11 @@ void nano::stat::log_samples_impl (stat_log_sink & sink)
 
 void nano::stat::update (uint32_t key_a, uint64_t value)
 {
+	if (counter_add (key_a, value))
+	{
+		return;
+	}
+
 	static file_writer log_count (config.log_counters_filename);
 	static file_writer log_sample (config.log_samples_filename);
 
@@ -313,10 +415,11 @@ void nano::stat::update (uint32_t key_a, uint64_t value)
 	{
 		auto entry (get_entry_impl (key_a, config.interval, config.capacity));
 
-		// Counters
-		auto old (entry->counter.get_value ());
+		// Counters, including anything counted in the shards before observers were added
+		auto sharded (counter_sum (counter_slot (key_a)));
+		auto old (entry->counter.get_value () + sharded);
 		entry->counter.add (value);
-		entry->count_observers.notify (old, entry->counter.get_value ());
+		entry->count_observers.notify (old, entry->counter.get_value () + sharded);
 
 		std::chrono::duration<double, std::milli> duration = now - log_last_count_writeout;
 		if (config.log_interval_counters > 0 && duration.count () > config.log_interval_counters)
@@ -375,6 +478,20 @@ void nano::stat::clear ()
 {
 	nano::unique_lock<std::mutex> lock (stat_mutex);
 	entries.clear ();
+	for (auto & state : slot_states)
+	{
+		state = slot_state::unregistered;
+	}
+	for (auto & shard_pointer : shards)
+	{
+		if (auto shard = shard_pointer.load ())
+		{
+			for (auto & value : shard->values)
+			{
+				value.store (0, std::memory_order_relaxed);
+			}
+		}
+	}
 	timestamp = std::chrono::steady_clock::now ();
 }
 
@@ -441,6 +558,15 @@ std::string nano::stat::type_to_string (uint32_t key)
 		case nano::stat::type::requests:
 			res = "requests";
 			break;
+		case nano::stat::type::filter:
+			res = "filter";
+			break;
+		case nano::stat::type::block_cache:
+			res = "block_cache";
+			break;
+		case nano::stat::type::websocket:
+			res = "websocket";
+			break;
 	}
 	return res;
 }
@@ -583,6 +709,15 @@ std::string nano::stat::detail_to_string (uint32_t key)
 		case nano::stat::detail::vote_overflow:
 			res = "vote_overflow";
 			break;
+		case nano::stat::detail::vote_filtered_replay:
+			res = "vote_filtered_replay";
+			break;
+		case nano::stat::detail::vote_signature_checked:
+			res = "vote_signature_checked";
+			break;
+		case nano::stat::detail::vote_signature_known:
+			res = "vote_signature_known";
+			break;
 		case nano::stat::detail::vote_new:
 			res = "vote_new";
 			break;
@@ -667,6 +802,24 @@ std::string nano::stat::detail_to_string (uint32_t key)
 		case nano::stat::detail::requests_dropped:
 			res = "requests_dropped";
 			break;
+		case nano::stat::detail::duplicate_publish:
+			res = "duplicate_publish";
+			break;
+		case nano::stat::detail::unique_publish:
+			res = "unique_publish";
+			break;
+		case nano::stat::detail::cache_hit:
+			res = "cache_hit";
+			break;
+		case nano::stat::detail::cache_miss:
+			res = "cache_miss";
+			break;
+		case nano::stat::detail::message_drop:
+			res = "message_drop";
+			break;
+		case nano::stat::detail::session_overflow:
+			res = "session_overflow";
+			break;
 	}
 	return res;
 }
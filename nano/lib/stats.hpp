@@ -5,6 +5,8 @@
 
 #include <boost/circular_buffer.hpp>
 
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <map>
 #include <memory>
@@ -198,7 +200,10 @@ public:
 		observer,
 		confirmation_height,
 		drop,
-		requests
+		requests,
+		filter,
+		block_cache,
+		websocket
 	};
 
 	/** Optional detail type */
@@ -261,6 +266,9 @@ public:
 		vote_indeterminate,
 		vote_invalid,
 		vote_overflow,
+		vote_filtered_replay,
+		vote_signature_checked,
+		vote_signature_known,
 
 		// election specific
 		vote_new,
@@ -303,7 +311,19 @@ public:
 		requests_cached,
 		requests_generated,
 		requests_ignored,
-		requests_dropped
+		requests_dropped,
+
+		// duplicate filter
+		duplicate_publish,
+		unique_publish,
+
+		// block cache
+		cache_hit,
+		cache_miss,
+
+		// websocket
+		message_drop,
+		session_overflow
 	};
 
 	/** Direction of the stat. If the direction is irrelevant, use in */
@@ -321,6 +341,7 @@ public:
 	 * @param config Configuration object; deserialized from config.json
 	 */
 	stat (nano::stat_config config);
+	~stat ();
 
 	/**
 	 * Call this to override the default sample interval and capacity, for a specific stat entry.
@@ -409,10 +430,7 @@ public:
 	 * To avoid recursion, the observer callback must only use the received counts, not query the stat object.
 	 * @param observer The observer receives the old and the new count.
 	 */
-	void observe_count (stat::type type, stat::detail detail, stat::dir dir, std::function<void(uint64_t, uint64_t)> observer)
-	{
-		get_entry (key_of (type, detail, dir))->count_observers.add (observer);
-	}
+	void observe_count (stat::type type, stat::detail detail, stat::dir dir, std::function<void(uint64_t, uint64_t)> observer);
 
 	/** Returns a potentially empty list of the last N samples, where N is determined by the 'capacity' configuration */
 	boost::circular_buffer<stat_datapoint> * samples (stat::type type, stat::detail detail, stat::dir dir)
@@ -427,10 +445,7 @@ public:
 	}
 
 	/** Returns current value for the given counter at the detail level */
-	uint64_t count (stat::type type, stat::detail detail, stat::dir dir = stat::dir::in)
-	{
-		return get_entry (key_of (type, detail, dir))->counter.get_value ();
-	}
+	uint64_t count (stat::type type, stat::detail detail, stat::dir dir = stat::dir::in);
 
 	/** Returns the number of seconds since clear() was last called, or node startup if it's never called. */
 	std::chrono::seconds last_reset ();
@@ -485,6 +500,46 @@ private:
 	/** Unlocked implementation of log_samples() to avoid using recursive locking */
 	void log_samples_impl (stat_log_sink & sink);
 
+	/**
+	 * Counters without observers are kept in shards rather than in their entry, so incrementing them takes no lock.
+	 * Each thread always uses the same shard, and the shards are summed when counters are read or logged.
+	 * Sampling and counter log writeout need every update, so the fast path is disabled when either is configured.
+	 */
+	class counter_shard final
+	{
+	public:
+		/** Padding on both sides keeps neighbouring allocations off the shard's cache lines */
+		char padding_front[64];
+		std::array<std::atomic<uint64_t>, 32 * 128 * 2> values;
+		char padding_back[64];
+	};
+	static size_t constexpr counter_shards = 16;
+	static size_t constexpr counter_slots = std::tuple_size<decltype (counter_shard::values)>::value;
+
+	/** Index of the counter slot for key, or counter_slots if the type or detail is outside the covered range */
+	static size_t counter_slot (uint32_t key);
+
+	/** Adds to the calling thread's shard. Returns false if the update must take the slow path */
+	bool counter_add (uint32_t key, uint64_t value);
+
+	/** Sum of a counter slot over all shards */
+	uint64_t counter_sum (size_t slot) const;
+
+	/** Shards are allocated on first use by a thread mapped to them */
+	std::array<std::atomic<counter_shard *>, counter_shards> shards{};
+
+	/** Per slot state, see slot_state */
+	std::array<std::atomic<uint8_t>, counter_slots> slot_states{};
+	enum slot_state : uint8_t
+	{
+		/** No entry exists yet, the first update creates it */
+		unregistered,
+		/** Entry exists, updates are counted in the shards */
+		registered,
+		/** Entry has count observers, all updates take the slow path */
+		observed
+	};
+
 	/** Time of last clear() call */
 	std::chrono::steady_clock::time_point timestamp{ std::chrono::steady_clock::now () };
 
@@ -497,7 +552,10 @@ private:
 	std::chrono::steady_clock::time_point log_last_sample_writeout{ std::chrono::steady_clock::now () };
 
 	/** Whether stats should be output */
-	bool stopped{ false };
+	std::atomic<bool> stopped{ false };
+
+	/** Set from the config, counters can only use the shards when neither sampling nor counter log writeout is enabled */
+	bool const fast_counters{ true };
 
 	/** All access to stat is thread safe, including calls from observers on the same thread */
 	std::mutex stat_mutex;
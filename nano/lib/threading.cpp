@@ -1,5 +1,8 @@
+#include <nano/boost/asio/post.hpp>
+#include <nano/lib/locks.hpp>
 #include <nano/lib/threading.hpp>
 
+#include <future>
 #include <iostream>
 
 namespace
@@ -72,6 +75,9 @@ std::string nano::thread_role::get_string (nano::thread_role::name role)
 		case nano::thread_role::name::request_aggregator:
 			thread_role_name_string = "Req aggregator";
 			break;
+		case nano::thread_role::name::voting_signing:
+			thread_role_name_string = "Voting signing";
+			break;
 	}
 
 	/*
@@ -98,6 +104,40 @@ void nano::thread_role::set (nano::thread_role::name role)
 	current_thread_role = role;
 }
 
+void nano::thread_role::set (boost::asio::thread_pool & pool_a, unsigned num_threads_a, nano::thread_role::name role_a)
+{
+	std::mutex mutex;
+	nano::condition_variable condition;
+	auto pending (num_threads_a);
+	std::vector<std::promise<void>> promises (num_threads_a);
+	std::vector<std::future<void>> futures;
+	futures.reserve (num_threads_a);
+	for (auto & promise : promises)
+	{
+		futures.push_back (promise.get_future ());
+		// Every pool thread must take one of these tasks, so each waits until all have started
+		boost::asio::post (pool_a, [&mutex, &condition, &pending, &promise, role_a]() {
+			nano::thread_role::set (role_a);
+			{
+				nano::unique_lock<std::mutex> lock (mutex);
+				if (--pending == 0)
+				{
+					condition.notify_all ();
+				}
+				else
+				{
+					condition.wait (lock, [&pending]() { return pending == 0; });
+				}
+			}
+			promise.set_value ();
+		});
+	}
+	for (auto & future : futures)
+	{
+		future.wait ();
+	}
+}
+
 void nano::thread_attributes::set (boost::thread::attributes & attrs)
 {
 	auto attrs_l (&attrs);
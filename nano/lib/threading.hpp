@@ -2,6 +2,7 @@
 
 #include <nano/boost/asio/executor_work_guard.hpp>
 #include <nano/boost/asio/io_context.hpp>
+#include <nano/boost/asio/thread_pool.hpp>
 #include <nano/lib/utility.hpp>
 
 #include <boost/thread/thread.hpp>
@@ -32,7 +33,8 @@ namespace thread_role
 		work_watcher,
 		confirmation_height_processing,
 		worker,
-		request_aggregator
+		request_aggregator,
+		voting_signing
 	};
 	/*
 	 * Get/Set the identifier for the current thread
@@ -54,6 +56,11 @@ namespace thread_role
 	 * Internal only, should not be called directly
 	 */
 	void set_os_name (std::string const &);
+
+	/*
+	 * Set the identifier of every thread of a pool, returning once all of them have it
+	 */
+	void set (boost::asio::thread_pool &, unsigned num_threads, nano::thread_role::name);
 }
 
 namespace thread_attributes
@@ -89,6 +89,11 @@ int main (int argc, char * const * argv)
 		("debug_profile_sign", "Profile signature generation")
 		("debug_profile_process", "Profile active blocks processing (only for nano_test_network)")
 		("debug_profile_votes", "Profile votes processing (only for nano_test_network)")
+		("debug_profile_election_votes", "Profile vote tallying inside a single election (only for nano_test_network)")
+		("debug_profile_rocksdb_tables", "Profile RocksDB point lookups and pending scans with and without per table tuning")
+		("debug_profile_read_txn", "Profile LMDB read transaction setup with and without pooling across multiple threads")
+		("debug_profile_stats", "Profile concurrent statistics counter increments on the lock-free and locked paths")
+		("debug_profile_rep_weights", "Profile concurrent representative weight updates and lookups")
 		("debug_random_feed", "Generates output to RNG test suites")
 		("debug_rpc", "Read an RPC command from stdin and invoke it. Network operations will have no effect.")
 		("debug_validate_blocks", "Check all blocks for correct hash, signature, work value")
@@ -683,7 +688,27 @@ int main (int argc, char * const * argv)
 			auto begin (std::chrono::high_resolution_clock::now ());
 			nano::validate_message_batch (messages.data (), lengths.data (), pub_keys.data (), signatures.data (), batch_count, verifications.data ());
 			auto end (std::chrono::high_resolution_clock::now ());
-			std::cerr << "Batch signature verifications " << std::chrono::duration_cast<std::chrono::microseconds> (end - begin).count () << std::endl;
+			auto time (std::max<int64_t> (1, std::chrono::duration_cast<std::chrono::microseconds> (end - begin).count ()));
+			std::cerr << "Batch signature verifications " << time << std::endl;
+			std::cerr << boost::str (boost::format ("%1% verifications per second on a single thread\n") % (batch_count * 1000000 / time));
+			// Throughput of the signature checker thread pool for each task size, see --signature_checker_batch_size
+			size_t checker_count (64 * 1024);
+			messages.resize (checker_count, message.bytes.data ());
+			lengths.resize (checker_count, sizeof (message));
+			pub_keys.resize (checker_count, key.pub.bytes.data ());
+			signatures.resize (checker_count, signature.bytes.data ());
+			verifications.resize (checker_count);
+			nano::node_config config;
+			for (size_t batch_size (64); batch_size <= 4096; batch_size *= 2)
+			{
+				nano::signature_checker checker (config.signature_checker_threads, batch_size);
+				nano::signature_check_set check (checker_count, messages.data (), lengths.data (), pub_keys.data (), signatures.data (), verifications.data ());
+				auto begin1 (std::chrono::high_resolution_clock::now ());
+				checker.verify (check);
+				auto end1 (std::chrono::high_resolution_clock::now ());
+				auto time1 (std::max<int64_t> (1, std::chrono::duration_cast<std::chrono::microseconds> (end1 - begin1).count ()));
+				std::cerr << boost::str (boost::format ("%1% verifications per second with %2% threads and batch size %3%\n") % (checker_count * 1000000 / time1) % (config.signature_checker_threads + 1) % batch_size);
+			}
 		}
 		else if (vm.count ("debug_profile_sign"))
 		{
@@ -922,6 +947,291 @@ int main (int argc, char * const * argv)
 			node->stop ();
 			std::cerr << boost::str (boost::format ("%|1$ 12d| us \n%2% votes per second\n") % time % (max_votes * 1000000 / time));
 		}
+		else if (vm.count ("debug_profile_election_votes"))
+		{
+			nano::network_constants::set_active_network (nano::nano_networks::nano_test_network);
+			nano::network_params test_params;
+			nano::block_builder builder;
+			size_t num_representatives (5000);
+			size_t num_rounds (20);
+			size_t max_votes (num_representatives * num_rounds); // 5,000 * 20 = 100,000 votes
+			std::cerr << boost::str (boost::format ("Starting pregenerating %1% representatives\n") % num_representatives);
+			nano::system system (1);
+			nano::work_pool work (std::numeric_limits<unsigned>::max ());
+			nano::logging logging;
+			auto path (nano::unique_path ());
+			logging.init (path);
+			nano::node_flags flags;
+			flags.disable_request_loop = true;
+			auto node (std::make_shared<nano::node> (system.io_ctx, path, system.alarm, nano::node_config (24001, logging), work, flags));
+			nano::block_hash genesis_latest (node->latest (test_params.ledger.test_genesis_key.pub));
+			nano::uint128_t genesis_balance (std::numeric_limits<nano::uint128_t>::max ());
+			// Representatives share a weight far below online_weight_minimum so the election never confirms
+			std::vector<nano::keypair> keys (num_representatives);
+			nano::uint128_t balance (1000);
+			{
+				auto transaction (node->store.tx_begin_write ());
+				for (auto i (0); i != num_representatives; ++i)
+				{
+					genesis_balance = genesis_balance - balance;
+
+					auto send = builder.state ()
+					            .account (test_params.ledger.test_genesis_key.pub)
+					            .previous (genesis_latest)
+					            .representative (test_params.ledger.test_genesis_key.pub)
+					            .balance (genesis_balance)
+					            .link (keys[i].pub)
+					            .sign (test_params.ledger.test_genesis_key.prv, test_params.ledger.test_genesis_key.pub)
+					            .work (*work.generate (genesis_latest))
+					            .build ();
+
+					genesis_latest = send->hash ();
+					node->ledger.process (transaction, *send);
+
+					auto open = builder.state ()
+					            .account (keys[i].pub)
+					            .previous (0)
+					            .representative (keys[i].pub)
+					            .balance (balance)
+					            .link (genesis_latest)
+					            .sign (keys[i].prv, keys[i].pub)
+					            .work (*work.generate (keys[i].pub))
+					            .build ();
+
+					node->ledger.process (transaction, *open);
+				}
+			}
+			nano::keypair destination;
+			auto send = builder.state ()
+			            .account (test_params.ledger.test_genesis_key.pub)
+			            .previous (genesis_latest)
+			            .representative (test_params.ledger.test_genesis_key.pub)
+			            .balance (genesis_balance - 1)
+			            .link (destination.pub)
+			            .sign (test_params.ledger.test_genesis_key.prv, test_params.ledger.test_genesis_key.pub)
+			            .work (*work.generate (genesis_latest))
+			            .build ();
+			std::shared_ptr<nano::block> block (std::move (send));
+			node->ledger.process (node->store.tx_begin_write (), *block);
+			node->active.start (block);
+			std::shared_ptr<nano::election> election;
+			{
+				nano::lock_guard<std::mutex> lock (node->active.mutex);
+				election = node->active.roots.find (block->qualified_root ())->election;
+			}
+			// Every round each representative replaces its previous vote
+			std::cerr << boost::str (boost::format ("Starting processing %1% votes from %2% representatives\n") % max_votes % num_representatives);
+			auto hash (block->hash ());
+			std::chrono::steady_clock::duration time (0);
+			for (uint64_t round (1); round <= num_rounds; ++round)
+			{
+				nano::lock_guard<std::mutex> lock (node->active.mutex);
+				// Pretend the vote cooldown has passed
+				for (auto & vote_info : election->last_votes)
+				{
+					vote_info.second.time = std::chrono::steady_clock::time_point::min ();
+				}
+				auto begin (std::chrono::steady_clock::now ());
+				for (auto & key : keys)
+				{
+					election->vote (key.pub, round, hash);
+				}
+				time += std::chrono::steady_clock::now () - begin;
+			}
+			auto us (std::max<int64_t> (1, std::chrono::duration_cast<std::chrono::microseconds> (time).count ()));
+			node->stop ();
+			std::cerr << boost::str (boost::format ("%|1$ 12d| us \n%2% votes per second\n") % us % (max_votes * 1000000 / us));
+		}
+		else if (vm.count ("debug_profile_rocksdb_tables"))
+		{
+#if NANO_ROCKSDB
+			size_t num_accounts (50000);
+			size_t blocks_per_account (4);
+			size_t num_lookups (200000);
+			std::cerr << boost::str (boost::format ("Starting generating %1% blocks\n") % (num_accounts * blocks_per_account));
+			nano::keypair key;
+			std::vector<nano::account> accounts (num_accounts);
+			std::vector<std::shared_ptr<nano::state_block>> blocks;
+			blocks.reserve (num_accounts * blocks_per_account);
+			for (auto & account : accounts)
+			{
+				nano::random_pool::generate_block (account.bytes.data (), account.bytes.size ());
+				nano::block_hash previous (0);
+				for (size_t i (0); i != blocks_per_account; ++i)
+				{
+					blocks.push_back (std::make_shared<nano::state_block> (account, previous, account, nano::uint128_t (i), account, key.prv, key.pub, 0));
+					previous = blocks.back ()->hash ();
+				}
+			}
+			std::vector<nano::block_hash> missing (num_lookups);
+			for (auto & hash : missing)
+			{
+				nano::random_pool::generate_block (hash.bytes.data (), hash.bytes.size ());
+			}
+			auto measure = [](std::function<void()> const & action_a) {
+				auto begin (std::chrono::steady_clock::now ());
+				action_a ();
+				return std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::steady_clock::now () - begin).count ();
+			};
+			for (auto table_profiles : { false, true })
+			{
+				nano::logger_mt logger;
+				nano::rocksdb_config rocksdb_config;
+				rocksdb_config.enable = true;
+				rocksdb_config.bloom_filter_bits = 10;
+				rocksdb_config.table_profiles = table_profiles;
+				auto path (nano::unique_path ());
+				{
+					auto store (nano::make_store (logger, path, false, false, rocksdb_config, nano::txn_tracking_config{}, std::chrono::milliseconds (5000), 128, 512, false, true));
+					{
+						auto transaction (store->tx_begin_write ());
+						for (auto const & block : blocks)
+						{
+							nano::block_sideband sideband (nano::block_type::state, block->account (), 0, block->balance (), 1, nano::seconds_since_epoch (), nano::epoch::epoch_0);
+							store->block_put (transaction, block->hash (), *block, sideband);
+							store->pending_put (transaction, nano::pending_key (block->account (), block->hash ()), nano::pending_info (block->account (), block->balance (), nano::epoch::epoch_0));
+						}
+					}
+					auto transaction (store->tx_begin_read ());
+					size_t found (0);
+					auto hits_us (measure ([&]() {
+						for (size_t i (0); i != num_lookups; ++i)
+						{
+							found += store->block_exists (transaction, blocks[nano::random_pool::generate_word32 (0, blocks.size () - 1)]->hash ());
+						}
+					}));
+					auto misses_us (measure ([&]() {
+						for (auto const & hash : missing)
+						{
+							found += store->block_exists (transaction, hash);
+						}
+					}));
+					size_t scanned (0);
+					auto scans_us (measure ([&]() {
+						for (size_t i (0); i != num_lookups; ++i)
+						{
+							auto const & account (accounts[nano::random_pool::generate_word32 (0, accounts.size () - 1)]);
+							for (auto j (store->pending_begin (transaction, nano::pending_key (account, 0))), n (store->pending_end ()); j != n && nano::pending_key (j->first).account == account; ++j)
+							{
+								++scanned;
+							}
+						}
+					}));
+					std::cout << boost::str (boost::format ("table_profiles %1%: existing lookups %2% ns, missing lookups %3% ns, pending scans %4% ns (%5% found, %6% scanned)\n") % table_profiles % (hits_us * 1000 / num_lookups) % (misses_us * 1000 / num_lookups) % (scans_us * 1000 / num_lookups) % found % scanned);
+				}
+				boost::filesystem::remove_all (path);
+			}
+#else
+			std::cerr << "RocksDB support is not enabled in this build\n";
+			result = -1;
+#endif
+		}
+		else if (vm.count ("debug_profile_read_txn"))
+		{
+			size_t txns_per_thread (200000);
+			auto path (nano::unique_path ());
+			{
+				bool error (false);
+				nano::mdb_env env (error, path);
+				release_assert (!error);
+				// Stay below the default limit of 126 LMDB readers
+				for (auto num_threads : { 1U, 4U, 16U, std::min (64U, std::max (1U, std::thread::hardware_concurrency ())) })
+				{
+					for (auto pooled : { false, true })
+					{
+						std::vector<std::thread> threads;
+						auto begin (std::chrono::steady_clock::now ());
+						for (size_t i (0); i != num_threads; ++i)
+						{
+							threads.emplace_back ([&env, pooled, txns_per_thread]() {
+								for (size_t j (0); j != txns_per_thread; ++j)
+								{
+									auto transaction (pooled ? env.tx_begin_read_pooled () : env.tx_begin_read ());
+								}
+							});
+						}
+						for (auto & thread : threads)
+						{
+							thread.join ();
+						}
+						auto time (std::chrono::duration_cast<std::chrono::nanoseconds> (std::chrono::steady_clock::now () - begin).count ());
+						std::cout << boost::str (boost::format ("%1% threads, pooled %2%: %3% ns per transaction\n") % num_threads % pooled % (time / (num_threads * txns_per_thread)));
+					}
+				}
+			}
+			boost::filesystem::remove_all (path);
+		}
+		else if (vm.count ("debug_profile_stats"))
+		{
+			unsigned num_threads (32);
+			size_t increments_per_thread (1000000);
+			for (auto observed : { false, true })
+			{
+				nano::stat stats;
+				if (observed)
+				{
+					// Counters with observers always take the locked path
+					stats.observe_count (nano::stat::type::message, nano::stat::detail::confirm_ack, nano::stat::dir::in, [](uint64_t, uint64_t) {});
+				}
+				std::vector<std::thread> threads;
+				auto begin (std::chrono::steady_clock::now ());
+				for (unsigned i (0); i != num_threads; ++i)
+				{
+					threads.emplace_back ([&stats, increments_per_thread]() {
+						for (size_t j (0); j != increments_per_thread; ++j)
+						{
+							stats.inc (nano::stat::type::message, nano::stat::detail::confirm_ack, nano::stat::dir::in);
+						}
+					});
+				}
+				for (auto & thread : threads)
+				{
+					thread.join ();
+				}
+				auto time (std::chrono::duration_cast<std::chrono::nanoseconds> (std::chrono::steady_clock::now () - begin).count ());
+				auto total (stats.count (nano::stat::type::message, nano::stat::detail::confirm_ack, nano::stat::dir::in));
+				std::cout << boost::str (boost::format ("%1%: %2% threads, %3% ns per increment, %4% counted\n") % (observed ? "locked" : "lock-free") % num_threads % (time / (num_threads * increments_per_thread)) % total);
+			}
+		}
+		else if (vm.count ("debug_profile_rep_weights"))
+		{
+			std::vector<nano::account> reps;
+			for (auto i (0); i < 256; ++i)
+			{
+				reps.push_back (nano::keypair ().pub);
+			}
+			size_t operations_per_thread (1000000);
+			for (auto num_threads : { 1U, 4U, 16U })
+			{
+				nano::rep_weights rep_weights;
+				std::vector<std::thread> threads;
+				auto begin (std::chrono::steady_clock::now ());
+				for (unsigned i (0); i != num_threads; ++i)
+				{
+					// Half the threads update weights as the ledger does, the others read them as vote tallying does
+					threads.emplace_back ([&rep_weights, &reps, i, operations_per_thread]() {
+						for (size_t j (0); j != operations_per_thread; ++j)
+						{
+							auto const & rep (reps[(i + j) % reps.size ()]);
+							if (i % 2 == 0)
+							{
+								rep_weights.representation_add (rep, 1);
+							}
+							else
+							{
+								rep_weights.representation_get (rep);
+							}
+						}
+					});
+				}
+				for (auto & thread : threads)
+				{
+					thread.join ();
+				}
+				auto time (std::chrono::duration_cast<std::chrono::nanoseconds> (std::chrono::steady_clock::now () - begin).count ());
+				std::cout << boost::str (boost::format ("%1% threads: %2% ns per operation\n") % num_threads % (time / (num_threads * operations_per_thread)));
+			}
+		}
 		else if (vm.count ("debug_random_feed"))
 		{
 			/*
@@ -1210,7 +1520,7 @@ int main (int argc, char * const * argv)
 				block_count_2 = node2.node->store.block_count (transaction_2).sum ();
 				if ((count % 60) == 0)
 				{
-					std::cout << boost::str (boost::format ("%1% (%2%) blocks processed") % block_count_2 % node2.node->store.unchecked_count (transaction_2)) << std::endl;
+					std::cout << boost::str (boost::format ("%1% (%2%) blocks processed") % block_count_2 % node2.node->unchecked.count (transaction_2)) << std::endl;
 				}
 				count++;
 			}
@@ -212,7 +212,6 @@ void nano::active_transactions::request_confirm (nano::unique_lock<std::mutex> &
 {
 	assert (!mutex.try_lock ());
 	auto transaction_l (node.store.tx_begin_read ());
-	std::unordered_set<nano::qualified_root> inactive_l;
 	/*
 	 * Confirm frontiers when there aren't many confirmations already pending and node finished initial bootstrap
 	 * In auto mode start confirm only if node contains almost principal representative (half of required for principal weight)
@@ -230,6 +229,25 @@ void nano::active_transactions::request_confirm (nano::unique_lock<std::mutex> &
 			lock_a.lock ();
 		}
 	}
+	request_confirm (lock_a, transaction_l, sorted_roots ());
+}
+
+nano::active_transactions::roots_snapshot nano::active_transactions::sorted_roots ()
+{
+	assert (!mutex.try_lock ());
+	roots_snapshot result;
+	result.reserve (roots.size ());
+	for (auto & info : roots.get<tag_difficulty> ())
+	{
+		result.emplace_back (info.root, info.election);
+	}
+	return result;
+}
+
+void nano::active_transactions::request_confirm (nano::unique_lock<std::mutex> & lock_a, nano::transaction const & transaction_a, roots_snapshot sorted_roots_a)
+{
+	assert (!mutex.try_lock ());
+	std::unordered_map<nano::qualified_root, std::shared_ptr<nano::election>> inactive_l;
 	auto const now (std::chrono::steady_clock::now ());
 	// Any new election started from process_live only gets requests after at least 1 second
 	auto cutoff_l (now - election_request_delay);
@@ -242,8 +260,7 @@ void nano::active_transactions::request_confirm (nano::unique_lock<std::mutex> &
 	// Rate-limitting confirmation requests
 	auto const request_cutoff (now - min_time_between_requests);
 
-	auto roots_size_l (roots.size ());
-	auto & sorted_roots_l = roots.get<tag_difficulty> ();
+	auto roots_size_l (sorted_roots_a.size ());
 	size_t count_l{ 0 };
 
 	// Only representatives ready to receive batched confirm_req
@@ -255,26 +272,44 @@ void nano::active_transactions::request_confirm (nano::unique_lock<std::mutex> &
 	 * Only up to a certain amount of elections are queued for confirmation request and block rebroadcasting. The remaining elections can still be confirmed if votes arrive
 	 * Elections extending the soft config.active_elections_size limit are flushed after a certain time-to-live cutoff
 	 * Flushed elections are later re-activated via frontier confirmation
+	 * The mutex is released every request_confirm_batch_size elections so vote and block processing are not stalled behind a whole pass
 	 */
-	for (auto i = sorted_roots_l.begin (), n = sorted_roots_l.end (); i != n; ++i, ++count_l)
+	for (auto i = sorted_roots_a.begin (), n = sorted_roots_a.end (); i != n && !stopped; ++i, ++count_l)
 	{
-		auto election_l (i->election);
-		auto root_l (i->root);
-		if (election_l->confirmed || (election_l->confirmation_request_count != 0 && !node.ledger.could_fit (transaction_l, *election_l->status.winner)))
+		if (count_l != 0 && count_l % request_confirm_batch_size == 0)
+		{
+			lock_a.unlock ();
+			std::this_thread::yield ();
+			lock_a.lock ();
+		}
+		auto & root_l (i->first);
+		auto & election_l (i->second);
+		// Skip elections which finished while the mutex was released
+		auto existing_l (roots.get<tag_root> ().find (root_l));
+		if (existing_l == roots.get<tag_root> ().end () || existing_l->election != election_l)
+		{
+			continue;
+		}
+		if (election_l->confirmed || (election_l->confirmation_request_count != 0 && !node.ledger.could_fit (transaction_a, *election_l->status.winner)))
 		{
 			election_l->stop ();
 		}
 		// Erase finished elections
 		if ((election_l->stopped))
 		{
-			inactive_l.insert (root_l);
+			inactive_l.emplace (root_l, election_l);
 		}
 		// Drop elections
 		else if (count_l >= node.config.active_elections_size && election_l->election_start < election_ttl_cutoff_l && !node.wallets.watcher->is_watched (root_l))
 		{
 			election_l->stop ();
-			inactive_l.insert (root_l);
+			inactive_l.emplace (root_l, election_l);
 			add_dropped_elections_cache (root_l);
+			// Let republished blocks restart the election
+			for (auto const & block : election_l->blocks)
+			{
+				node.network.publish_filter.clear (*block.second);
+			}
 		}
 		// Attempt obtaining votes
 		else if (election_l->skip_delay || election_l->election_start < cutoff_l)
@@ -293,7 +328,7 @@ void nano::active_transactions::request_confirm (nano::unique_lock<std::mutex> &
 			// Escalate long election after a certain time and number of requests performed
 			if (election_l->confirmation_request_count > 4 && election_l->election_start < long_election_cutoff_l)
 			{
-				election_escalate (election_l, transaction_l, roots_size_l);
+				election_escalate (election_l, transaction_a, roots_size_l);
 			}
 		}
 	}
@@ -303,8 +338,8 @@ void nano::active_transactions::request_confirm (nano::unique_lock<std::mutex> &
 	// Erase inactive elections
 	for (auto i (inactive_l.begin ()), n (inactive_l.end ()); i != n; ++i)
 	{
-		auto root_it (roots.get<tag_root> ().find (*i));
-		if (root_it != roots.get<tag_root> ().end ())
+		auto root_it (roots.get<tag_root> ().find (i->first));
+		if (root_it != roots.get<tag_root> ().end () && root_it->election == i->second)
 		{
 			root_it->election->clear_blocks ();
 			root_it->election->clear_dependent ();
@@ -605,6 +640,38 @@ nano::vote_code nano::active_transactions::vote (std::shared_ptr<nano::vote> vot
 	}
 }
 
+bool nano::active_transactions::replay (nano::vote const & vote_a)
+{
+	assert (!mutex.try_lock ());
+	auto result (!vote_a.blocks.empty ());
+	for (auto i (vote_a.blocks.begin ()), n (vote_a.blocks.end ()); i != n && result; ++i)
+	{
+		std::shared_ptr<nano::election> election;
+		nano::block_hash hash;
+		if (i->which ())
+		{
+			hash = boost::get<nano::block_hash> (*i);
+			auto existing (blocks.find (hash));
+			if (existing != blocks.end ())
+			{
+				election = existing->second;
+			}
+		}
+		else
+		{
+			auto block (boost::get<std::shared_ptr<nano::block>> (*i));
+			hash = block->hash ();
+			auto existing (roots.get<tag_root> ().find (block->qualified_root ()));
+			if (existing != roots.get<tag_root> ().end ())
+			{
+				election = existing->election;
+			}
+		}
+		result = election != nullptr && election->replay (vote_a.account, vote_a.sequence, hash);
+	}
+	return result;
+}
+
 bool nano::active_transactions::active (nano::qualified_root const & root_a)
 {
 	nano::lock_guard<std::mutex> lock (mutex);
@@ -662,12 +729,21 @@ void nano::active_transactions::update_difficulty (std::shared_ptr<nano::block>
 					{
 						// Re-writing the block is necessary to avoid the same work being received later to force restarting the election
 						// The existing block is re-written, not the arriving block, as that one might not have gone through a full signature check
-						existing_block->block_work_set (block_a->block_work ());
-						node.store.block_put (*opt_transaction_a, hash, *existing_block, existing_sideband);
+						// Blocks returned by the store can be shared with other readers through the block cache, so the work is set on a copy
+						std::vector<uint8_t> bytes;
+						{
+							nano::vectorstream stream (bytes);
+							existing_block->serialize (stream);
+						}
+						nano::bufferstream stream (bytes.data (), bytes.size ());
+						auto upgraded_block (nano::deserialize_block (stream, existing_block->type ()));
+						release_assert (upgraded_block != nullptr);
+						upgraded_block->block_work_set (block_a->block_work ());
+						node.store.block_put (*opt_transaction_a, hash, *upgraded_block, existing_sideband);
 
 						// Restart election for the upgraded block, previously dropped from elections
 						lock.lock ();
-						add (existing_block);
+						add (upgraded_block);
 					}
 				}
 			}
@@ -81,6 +81,8 @@ public:
 	// clang-format on
 	// Distinguishes replay votes, cannot be determined if the block is not in any election
 	nano::vote_code vote (std::shared_ptr<nano::vote>);
+	// True if every block in the vote has an active election that would reject it as a replay. Note: mutex lock is required
+	bool replay (nano::vote const &);
 	// Is the root of this block in the roots container
 	bool active (nano::block const &);
 	bool active (nano::qualified_root const &);
@@ -138,6 +140,10 @@ private:
 	void search_frontiers (nano::transaction const &);
 	void election_escalate (std::shared_ptr<nano::election> &, nano::transaction const &, size_t const &);
 	void request_confirm (nano::unique_lock<std::mutex> &);
+	// Snapshot of the elections in descending order of difficulty, so the mutex can be released between batches of a pass
+	using roots_snapshot = std::vector<std::pair<nano::qualified_root, std::shared_ptr<nano::election>>>;
+	roots_snapshot sorted_roots ();
+	void request_confirm (nano::unique_lock<std::mutex> &, nano::transaction const &, roots_snapshot);
 	nano::account next_frontier_account{ 0 };
 	std::chrono::steady_clock::time_point next_frontier_check{ std::chrono::steady_clock::now () };
 	nano::condition_variable condition;
@@ -181,6 +187,8 @@ private:
 	void prioritize_account_for_confirmation (prioritize_num_uncemented &, size_t &, nano::account const &, nano::account_info const &, uint64_t);
 	static size_t constexpr max_priority_cementable_frontiers{ 100000 };
 	static size_t constexpr confirmed_frontiers_max_pending_cut_off{ 1000 };
+	// Number of elections visited by request_confirm before briefly releasing the mutex
+	static size_t constexpr request_confirm_batch_size{ 128 };
 	nano::gap_cache::ordered_gaps inactive_votes_cache;
 	static size_t constexpr inactive_votes_cache_max{ 16 * 1024 };
 	// clang-format off
@@ -199,6 +207,7 @@ private:
 	friend class confirmation_height_many_accounts_single_confirmation_Test;
 	friend class confirmation_height_many_accounts_many_confirmations_Test;
 	friend class confirmation_height_long_chains_Test;
+	friend class active_transactions_request_confirm_replaced_Test;
 };
 
 std::unique_ptr<container_info_component> collect_container_info (active_transactions & active_transactions, const std::string & name);
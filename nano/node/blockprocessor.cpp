@@ -8,6 +8,98 @@
 #include <cassert>
 
 std::chrono::milliseconds constexpr nano::block_processor::confirmation_request_delay;
+size_t constexpr nano::prioritized_blocks::balance_tiers;
+size_t constexpr nano::prioritized_blocks::age_tiers;
+size_t constexpr nano::prioritized_blocks::bucket_count;
+std::chrono::seconds constexpr nano::prioritized_blocks::recent_age;
+
+void nano::prioritized_blocks::push (nano::unchecked_info const & info_a, nano::account const & account_a, size_t bucket_a)
+{
+	assert (bucket_a < bucket_count);
+	auto bucket_l (bucket_a);
+	if (!account_a.is_zero ())
+	{
+		auto existing (accounts.find (account_a));
+		if (existing != accounts.end ())
+		{
+			bucket_l = existing->second.first;
+			++existing->second.second;
+		}
+		else
+		{
+			accounts.emplace (account_a, std::make_pair (bucket_a, size_t (1)));
+		}
+	}
+	buckets[bucket_l].push_back ({ info_a, account_a });
+	++total;
+}
+
+nano::unchecked_info nano::prioritized_blocks::pop ()
+{
+	assert (!empty ());
+	while (buckets[current].empty () || served >= quantum (current))
+	{
+		current = (current + 1) % bucket_count;
+		served = 0;
+	}
+	auto & bucket_l (buckets[current]);
+	auto result (std::move (bucket_l.front ().info));
+	auto account (bucket_l.front ().account);
+	bucket_l.pop_front ();
+	++served;
+	--total;
+	if (!account.is_zero ())
+	{
+		auto existing (accounts.find (account));
+		assert (existing != accounts.end ());
+		if (--existing->second.second == 0)
+		{
+			accounts.erase (existing);
+		}
+	}
+	return result;
+}
+
+bool nano::prioritized_blocks::empty () const
+{
+	return total == 0;
+}
+
+size_t nano::prioritized_blocks::size () const
+{
+	return total;
+}
+
+size_t nano::prioritized_blocks::bucket_size (size_t bucket_a) const
+{
+	return buckets[bucket_a].size ();
+}
+
+size_t nano::prioritized_blocks::bucket (nano::uint128_t const & balance_a, std::chrono::seconds const & age_a)
+{
+	size_t balance_tier (0);
+	if (balance_a >= nano::Gxrb_ratio)
+	{
+		balance_tier = 3;
+	}
+	else if (balance_a >= nano::Mxrb_ratio)
+	{
+		balance_tier = 2;
+	}
+	else if (balance_a >= nano::kxrb_ratio)
+	{
+		balance_tier = 1;
+	}
+	size_t age_tier (age_a >= recent_age ? 1 : 0);
+	return balance_tier * age_tiers + age_tier;
+}
+
+size_t nano::prioritized_blocks::quantum (size_t bucket_a)
+{
+	auto balance_tier (bucket_a / age_tiers);
+	auto age_tier (bucket_a % age_tiers);
+	return (size_t (1) << balance_tier) * (age_tier + 1);
+}
 
 nano::block_processor::block_processor (nano::node & node_a, nano::write_database_queue & write_database_queue_a) :
 generator (node_a.config, node_a.store, node_a.wallets, node_a.vote_processor, node_a.votes_cache, node_a.network),
@@ -77,14 +169,7 @@ void nano::block_processor::add (nano::unchecked_info const & info_a)
 			nano::lock_guard<std::mutex> lock (mutex);
 			if (blocks_filter.find (filter_hash) == blocks_filter.end ())
 			{
-				if (info_a.verified == nano::signature_verification::unknown && (info_a.block->type () == nano::block_type::state || info_a.block->type () == nano::block_type::open || !info_a.account.is_zero ()))
-				{
-					state_blocks.push_back (info_a);
-				}
-				else
-				{
-					blocks.push_back (info_a);
-				}
+				state_blocks.push_back (info_a);
 				blocks_filter.insert (filter_hash);
 			}
 		}
@@ -97,6 +182,23 @@ void nano::block_processor::add (nano::unchecked_info const & info_a)
 	}
 }
 
+/** Queues a block whose signature was already checked straight into \p bucket_a, skipping pre-validation and its ledger lookups */
+void nano::block_processor::add_verified (nano::unchecked_info const & info_a, size_t bucket_a)
+{
+	assert (info_a.verified != nano::signature_verification::unknown);
+	{
+		auto filter_hash (filter_item (info_a.block->hash (), info_a.block->block_signature ()));
+		nano::lock_guard<std::mutex> lock (mutex);
+		if (blocks_filter.find (filter_hash) == blocks_filter.end ())
+		{
+			// Legacy blocks other than open don't name their account, they are only kept in order with their chain if the caller knew it
+			blocks.push (info_a, info_a.account.is_zero () ? info_a.block->account () : info_a.account, bucket_a);
+			blocks_filter.insert (filter_hash);
+		}
+	}
+	condition.notify_all ();
+}
+
 void nano::block_processor::force (std::shared_ptr<nano::block> block_a)
 {
 	{
@@ -151,24 +253,69 @@ bool nano::block_processor::have_blocks ()
 	return !blocks.empty () || !forced.empty () || !state_blocks.empty ();
 }
 
+/**
+ * Read-only pre-validation stage, run outside of the write transaction.
+ * Blocks already in the ledger are passed through without a signature check,
+ * the signing account of legacy blocks is resolved from their predecessor and
+ * signatures are batch verified across the signature checker threads. Blocks
+ * which can't be resolved yet are passed on unverified for the ledger to classify.
+ * Every block is then queued in the priority bucket of its account.
+ */
 void nano::block_processor::verify_state_blocks (nano::unique_lock<std::mutex> & lock_a, size_t max_count)
 {
 	assert (!mutex.try_lock ());
 	nano::timer<std::chrono::milliseconds> timer_l (nano::timer_state::started);
-	std::deque<nano::unchecked_info> items;
-	items.swap (state_blocks);
+	std::deque<nano::unchecked_info> candidates;
+	if (state_blocks.size () <= max_count)
+	{
+		candidates.swap (state_blocks);
+	}
+	else
+	{
+		auto end (state_blocks.begin () + max_count);
+		candidates.insert (candidates.end (), std::make_move_iterator (state_blocks.begin ()), std::make_move_iterator (end));
+		state_blocks.erase (state_blocks.begin (), end);
+	}
 	lock_a.unlock ();
-	if (!items.empty ())
+	if (!candidates.empty ())
 	{
-		auto size (items.size ());
+		// Signers of the candidates checked here, and their position in the queue
+		std::vector<nano::account> accounts;
+		accounts.reserve (candidates.size ());
+		std::vector<size_t> checked;
+		checked.reserve (candidates.size ());
+		// Account and priority bucket of every candidate
+		std::vector<std::pair<nano::account, size_t>> priorities;
+		priorities.reserve (candidates.size ());
+		{
+			auto transaction (node.store.tx_begin_read ());
+			for (auto & candidate : candidates)
+			{
+				nano::account account (0);
+				nano::account owner (0);
+				size_t bucket (0);
+				if (!node.store.block_exists (transaction, candidate.block->hash ()))
+				{
+					account = signing_account (transaction, candidate);
+					// Legacy blocks other than open don't name their account, it is their signer
+					owner = candidate.block->account ().is_zero () ? account : candidate.block->account ();
+					bucket = priority_bucket (transaction, owner, *candidate.block);
+				}
+				if (!account.is_zero () && candidate.verified == nano::signature_verification::unknown)
+				{
+					accounts.push_back (account);
+					checked.push_back (priorities.size ());
+				}
+				priorities.emplace_back (owner, bucket);
+			}
+		}
+		auto size (checked.size ());
 		std::vector<nano::block_hash> hashes;
 		hashes.reserve (size);
 		std::vector<unsigned char const *> messages;
 		messages.reserve (size);
 		std::vector<size_t> lengths;
 		lengths.reserve (size);
-		std::vector<nano::account> accounts;
-		accounts.reserve (size);
 		std::vector<unsigned char const *> pub_keys;
 		pub_keys.reserve (size);
 		std::vector<nano::signature> blocks_signatures;
@@ -179,62 +326,67 @@ void nano::block_processor::verify_state_blocks (nano::unique_lock<std::mutex> &
 		verifications.resize (size, 0);
 		for (auto i (0); i < size; ++i)
 		{
-			auto & item (items[i]);
+			auto & item (candidates[checked[i]]);
 			hashes.push_back (item.block->hash ());
 			messages.push_back (hashes.back ().bytes.data ());
 			lengths.push_back (sizeof (decltype (hashes)::value_type));
-			nano::account account (item.block->account ());
-			if (!item.block->link ().is_zero () && node.ledger.is_epoch_link (item.block->link ()))
-			{
-				account = node.ledger.epoch_signer (item.block->link ());
-			}
-			else if (!item.account.is_zero ())
-			{
-				account = item.account;
-			}
-			accounts.push_back (account);
-			pub_keys.push_back (accounts.back ().bytes.data ());
+			pub_keys.push_back (accounts[i].bytes.data ());
 			blocks_signatures.push_back (item.block->block_signature ());
 			signatures.push_back (blocks_signatures.back ().bytes.data ());
 		}
-		nano::signature_check_set check = { size, messages.data (), lengths.data (), pub_keys.data (), signatures.data (), verifications.data () };
-		node.checker.verify (check);
+		if (size != 0)
+		{
+			nano::signature_check_set check = { size, messages.data (), lengths.data (), pub_keys.data (), signatures.data (), verifications.data () };
+			node.checker.verify (check);
+		}
 		lock_a.lock ();
-		for (auto i (0); i < size; ++i)
+		// Candidates are queued in their original order, whether they were checked here or not
+		size_t next_checked (0);
+		for (size_t i (0), n (candidates.size ()); i < n; ++i)
 		{
-			assert (verifications[i] == 1 || verifications[i] == 0);
-			auto & item (items.front ());
-			if (!item.block->link ().is_zero () && node.ledger.is_epoch_link (item.block->link ()))
+			auto & item (candidates[i]);
+			auto const & priority (priorities[i]);
+			if (next_checked < size && checked[next_checked] == i)
 			{
-				// Epoch blocks
-				if (verifications[i] == 1)
+				auto verification (verifications[next_checked]);
+				assert (verification == 1 || verification == 0);
+				if (!item.block->link ().is_zero () && node.ledger.is_epoch_link (item.block->link ()))
+				{
+					// Epoch blocks
+					if (verification == 1)
+					{
+						item.verified = nano::signature_verification::valid_epoch;
+						blocks.push (item, priority.first, priority.second);
+					}
+					else
+					{
+						// Possible regular state blocks with epoch link (send subtype)
+						item.verified = nano::signature_verification::unknown;
+						blocks.push (item, priority.first, priority.second);
+					}
+				}
+				else if (verification == 1)
 				{
-					item.verified = nano::signature_verification::valid_epoch;
-					blocks.push_back (std::move (item));
+					// Non epoch blocks
+					item.verified = nano::signature_verification::valid;
+					blocks.push (item, priority.first, priority.second);
 				}
 				else
 				{
-					// Possible regular state blocks with epoch link (send subtype)
-					item.verified = nano::signature_verification::unknown;
-					blocks.push_back (std::move (item));
+					blocks_filter.erase (filter_item (hashes[next_checked], blocks_signatures[next_checked]));
+					requeue_invalid (hashes[next_checked], item);
 				}
-			}
-			else if (verifications[i] == 1)
-			{
-				// Non epoch blocks
-				item.verified = nano::signature_verification::valid;
-				blocks.push_back (std::move (item));
+				++next_checked;
 			}
 			else
 			{
-				blocks_filter.erase (filter_item (hashes[i], blocks_signatures[i]));
-				requeue_invalid (hashes[i], item);
+				// Old blocks and blocks with missing dependencies are classified by the ledger
+				blocks.push (item, priority.first, priority.second);
 			}
-			items.pop_front ();
 		}
 		if (node.config.logging.timing_logging ())
 		{
-			node.logger.try_log (boost::str (boost::format ("Batch verified %1% state blocks in %2% %3%") % size % timer_l.stop ().count () % timer_l.unit ()));
+			node.logger.try_log (boost::str (boost::format ("Batch verified %1% blocks (%2% passed through unverified) in %3% %4%") % size % (candidates.size () - size) % timer_l.stop ().count () % timer_l.unit ()));
 		}
 	}
 	else
@@ -243,6 +395,49 @@ void nano::block_processor::verify_state_blocks (nano::unique_lock<std::mutex> &
 	}
 }
 
+size_t nano::block_processor::priority_bucket (nano::transaction const & transaction_a, nano::account const & account_a, nano::block const & block_a)
+{
+	nano::uint128_t balance (0);
+	std::chrono::seconds age (0);
+	nano::account_info info;
+	if (!account_a.is_zero () && !node.store.account_get (transaction_a, account_a, info))
+	{
+		balance = info.balance.number ();
+		auto now (nano::seconds_since_epoch ());
+		age = std::chrono::seconds (now > info.modified ? now - info.modified : 0);
+	}
+	else if (block_a.type () == nano::block_type::state)
+	{
+		// Opening an account, prioritise by the balance it is opened with
+		balance = block_a.balance ().number ();
+	}
+	return nano::prioritized_blocks::bucket (balance, age);
+}
+
+nano::account nano::block_processor::signing_account (nano::transaction const & transaction_a, nano::unchecked_info const & info_a)
+{
+	nano::account result (info_a.block->account ());
+	if (!info_a.block->link ().is_zero () && node.ledger.is_epoch_link (info_a.block->link ()))
+	{
+		result = node.ledger.epoch_signer (info_a.block->link ());
+	}
+	else if (!info_a.account.is_zero ())
+	{
+		result = info_a.account;
+	}
+	else if (result.is_zero ())
+	{
+		// Legacy send, receive and change blocks are signed by the owner of their predecessor
+		nano::block_sideband sideband;
+		auto previous (node.store.block_get (transaction_a, info_a.block->previous (), &sideband));
+		if (previous != nullptr)
+		{
+			result = previous->account ().is_zero () ? sideband.account : previous->account ();
+		}
+	}
+	return result;
+}
+
 void nano::block_processor::process_batch (nano::unique_lock<std::mutex> & lock_a)
 {
 	nano::timer<std::chrono::milliseconds> timer_l;
@@ -296,8 +491,7 @@ void nano::block_processor::process_batch (nano::unique_lock<std::mutex> & lock_
 		bool force (false);
 		if (forced.empty ())
 		{
-			info = blocks.front ();
-			blocks.pop_front ();
+			info = blocks.pop ();
 			hash = info.block->hash ();
 			blocks_filter.erase (filter_item (hash, info.block->block_signature ()));
 		}
@@ -326,11 +520,12 @@ void nano::block_processor::process_batch (nano::unique_lock<std::mutex> & lock_
 				{
 					node.logger.always_log (boost::str (boost::format ("%1% blocks rolled back") % rollback_list.size ()));
 				}
-				// Deleting from votes cache & wallet work watcher, stop active transaction
+				// Deleting from votes cache, wallet work watcher & publish filter, stop active transaction
 				for (auto & i : rollback_list)
 				{
 					node.votes_cache.remove (i->hash ());
 					node.wallets.watcher->remove (i);
+					node.network.publish_filter.clear (*i);
 					// Stop all rolled back active transactions except initial
 					if (i->hash () != successor->hash ())
 					{
@@ -412,9 +607,7 @@ nano::process_return nano::block_processor::process_one (nano::write_transaction
 			}
 
 			nano::unchecked_key unchecked_key (info_a.block->previous (), hash);
-			auto exists = node.store.unchecked_exists (transaction_a, unchecked_key);
-			node.store.unchecked_put (transaction_a, unchecked_key, info_a);
-			if (!exists)
+			if (node.unchecked.put (transaction_a, unchecked_key, info_a))
 			{
 				++node.ledger.cache.unchecked_count;
 			}
@@ -435,9 +628,7 @@ nano::process_return nano::block_processor::process_one (nano::write_transaction
 			}
 
 			nano::unchecked_key unchecked_key (node.ledger.block_source (transaction_a, *(info_a.block)), hash);
-			auto exists = node.store.unchecked_exists (transaction_a, unchecked_key);
-			node.store.unchecked_put (transaction_a, unchecked_key, info_a);
-			if (!exists)
+			if (node.unchecked.put (transaction_a, unchecked_key, info_a))
 			{
 				++node.ledger.cache.unchecked_count;
 			}
@@ -535,18 +726,27 @@ nano::process_return nano::block_processor::process_one (nano::write_transaction
 
 void nano::block_processor::queue_unchecked (nano::write_transaction const & transaction_a, nano::block_hash const & hash_a)
 {
-	auto unchecked_blocks (node.store.unchecked_get (transaction_a, hash_a));
+	auto unchecked_blocks (node.unchecked.get (transaction_a, hash_a));
+	// Dependents inherit the priority of the block which resolved them, its account having just been modified
+	auto bucket (unchecked_blocks.empty () ? 0 : nano::prioritized_blocks::bucket (node.ledger.balance (transaction_a, hash_a), std::chrono::seconds (0)));
 	for (auto & info : unchecked_blocks)
 	{
 		if (!node.flags.fast_bootstrap)
 		{
-			if (!node.store.unchecked_del (transaction_a, nano::unchecked_key (hash_a, info.block->hash ())))
+			if (!node.unchecked.del (transaction_a, nano::unchecked_key (hash_a, info.block->hash ())))
 			{
 				assert (node.ledger.cache.unchecked_count > 0);
 				--node.ledger.cache.unchecked_count;
 			}
 		}
-		add (info);
+		if (info.verified != nano::signature_verification::unknown)
+		{
+			add_verified (info, bucket);
+		}
+		else
+		{
+			add (info);
+		}
 	}
 	node.gap_cache.erase (hash_a);
 }
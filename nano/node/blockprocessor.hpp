@@ -10,8 +10,11 @@
 #include <boost/multi_index/sequenced_index.hpp>
 #include <boost/multi_index_container.hpp>
 
+#include <array>
 #include <chrono>
+#include <deque>
 #include <memory>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace nano
@@ -21,6 +24,45 @@ class transaction;
 class write_transaction;
 class write_database_queue;
 
+/**
+ * Verified blocks awaiting the write transaction, bucketed by the balance of their account and the time since it was last modified.
+ * Buckets are served round robin, each taking up to its quantum of blocks per turn with higher balances and quieter accounts
+ * getting larger quanta, so a flood of dust from freshly modified accounts can't starve everything queued behind it.
+ * Not thread safe, guarded by the block processor mutex.
+ */
+class prioritized_blocks final
+{
+public:
+	/** Queues \p info_a in \p bucket_a, or in the bucket already holding blocks for \p account_a to keep its chain in order */
+	void push (nano::unchecked_info const & info_a, nano::account const & account_a, size_t bucket_a);
+	nano::unchecked_info pop ();
+	bool empty () const;
+	size_t size () const;
+	size_t bucket_size (size_t) const;
+	static size_t bucket (nano::uint128_t const & balance_a, std::chrono::seconds const & age_a);
+	/** Blocks served from \p bucket_a per round robin turn */
+	static size_t quantum (size_t bucket_a);
+	static size_t constexpr balance_tiers = 4;
+	static size_t constexpr age_tiers = 2;
+	static size_t constexpr bucket_count = balance_tiers * age_tiers;
+	/** Accounts modified more recently than this are in the lower priority age tier */
+	static std::chrono::seconds constexpr recent_age{ 300 };
+
+private:
+	class entry final
+	{
+	public:
+		nano::unchecked_info info;
+		nano::account account;
+	};
+	std::array<std::deque<entry>, bucket_count> buckets;
+	// Bucket and number of queued blocks per account
+	std::unordered_map<nano::account, std::pair<size_t, size_t>> accounts;
+	size_t current{ 0 };
+	size_t served{ 0 };
+	size_t total{ 0 };
+};
+
 /**
  * Processing blocks is a potentially long IO operation.
  * This class isolates block insertion from other operations like servicing network operations
@@ -50,7 +92,10 @@ public:
 
 private:
 	void queue_unchecked (nano::write_transaction const &, nano::block_hash const &);
+	void add_verified (nano::unchecked_info const &, size_t);
 	void verify_state_blocks (nano::unique_lock<std::mutex> &, size_t = std::numeric_limits<size_t>::max ());
+	nano::account signing_account (nano::transaction const &, nano::unchecked_info const &);
+	size_t priority_bucket (nano::transaction const &, nano::account const &, nano::block const &);
 	void process_batch (nano::unique_lock<std::mutex> &);
 	void process_live (nano::block_hash const &, std::shared_ptr<nano::block>, const bool = false);
 	void requeue_invalid (nano::block_hash const &, nano::unchecked_info const &);
@@ -58,8 +103,9 @@ private:
 	bool active;
 	bool awaiting_write{ false };
 	std::chrono::steady_clock::time_point next_log;
+	// Blocks of any type awaiting signature pre-validation and prioritisation
 	std::deque<nano::unchecked_info> state_blocks;
-	std::deque<nano::unchecked_info> blocks;
+	nano::prioritized_blocks blocks;
 	std::deque<std::shared_ptr<nano::block>> forced;
 	nano::block_hash filter_item (nano::block_hash const &, nano::signature const &);
 	std::unordered_set<nano::block_hash> blocks_filter;
@@ -300,5 +300,6 @@ public:
 	static constexpr uint64_t lazy_batch_pull_count_resize_blocks_limit = 4 * 1024 * 1024;
 	static constexpr double lazy_batch_pull_count_resize_ratio = 2.0;
 	static constexpr size_t lazy_blocks_restart_limit = 1024 * 1024;
+	static constexpr size_t bulk_pull_server_blocks_per_write = 128;
 };
 }
@@ -486,21 +486,34 @@ void nano::bulk_pull_server::set_current_end ()
 	}
 }
 
+/**
+ * Serializes up to bootstrap_limits::bulk_pull_server_blocks_per_write blocks
+ * into a single buffer, walking the chain inside one read transaction, so
+ * serving a long chain costs one transaction and one socket write per batch
+ * instead of per block.
+ */
 void nano::bulk_pull_server::send_next ()
 {
-	auto block (get_next ());
-	if (block != nullptr)
+	std::vector<uint8_t> send_buffer;
+	size_t count (0);
 	{
-		std::vector<uint8_t> send_buffer;
+		nano::vectorstream stream (send_buffer);
+		auto transaction (connection->node->store.tx_begin_read ());
+		auto block (get_next (transaction));
+		while (block != nullptr)
 		{
-			nano::vectorstream stream (send_buffer);
 			nano::serialize_block (stream, *block);
+			++count;
+			if (connection->node->config.logging.bulk_pull_logging ())
+			{
+				connection->node->logger.try_log (boost::str (boost::format ("Sending block: %1%") % block->hash ().to_string ()));
+			}
+			block = (count < nano::bootstrap_limits::bulk_pull_server_blocks_per_write) ? get_next (transaction) : nullptr;
 		}
+	}
+	if (count != 0)
+	{
 		auto this_l (shared_from_this ());
-		if (connection->node->config.logging.bulk_pull_logging ())
-		{
-			connection->node->logger.try_log (boost::str (boost::format ("Sending block: %1%") % block->hash ().to_string ()));
-		}
 		connection->socket->async_write (nano::shared_const_buffer (std::move (send_buffer)), [this_l](boost::system::error_code const & ec, size_t size_a) {
 			this_l->sent_action (ec, size_a);
 		});
@@ -512,6 +525,12 @@ void nano::bulk_pull_server::send_next ()
 }
 
 std::shared_ptr<nano::block> nano::bulk_pull_server::get_next ()
+{
+	auto transaction (connection->node->store.tx_begin_read ());
+	return get_next (transaction);
+}
+
+std::shared_ptr<nano::block> nano::bulk_pull_server::get_next (nano::transaction const & transaction_a)
 {
 	std::shared_ptr<nano::block> result;
 	bool send_current = false, set_current_to_end = false;
@@ -552,8 +571,7 @@ std::shared_ptr<nano::block> nano::bulk_pull_server::get_next ()
 
 	if (send_current)
 	{
-		auto transaction (connection->node->store.tx_begin_read ());
-		result = connection->node->store.block_get (transaction, current);
+		result = connection->node->store.block_get (transaction_a, current);
 		if (result != nullptr && set_current_to_end == false)
 		{
 			auto previous (result->previous ());
@@ -61,6 +61,7 @@ public:
 	bulk_pull_server (std::shared_ptr<nano::bootstrap_server> const &, std::unique_ptr<nano::bulk_pull>);
 	void set_current_end ();
 	std::shared_ptr<nano::block> get_next ();
+	std::shared_ptr<nano::block> get_next (nano::transaction const &);
 	void send_next ();
 	void sent_action (boost::system::error_code const &, size_t);
 	void send_finished ();
@@ -402,15 +402,25 @@ void nano::bootstrap_server::receive_publish_action (boost::system::error_code c
 {
 	if (!ec)
 	{
-		auto error (false);
-		nano::bufferstream stream (receive_buffer->data (), size_a);
-		auto request (std::make_unique<nano::publish> (error, stream, header_a));
-		if (!error)
+		nano::network_filter::digest_t digest (0);
+		if (!node->network.publish_filter.apply (receive_buffer->data (), size_a, &digest))
 		{
-			if (is_realtime_connection ())
+			auto error (false);
+			nano::bufferstream stream (receive_buffer->data (), size_a);
+			auto request (std::make_unique<nano::publish> (error, stream, header_a, &node->block_uniquer));
+			if (!error)
 			{
-				add_request (std::unique_ptr<nano::message> (request.release ()));
+				request->digest = digest;
+				if (is_realtime_connection ())
+				{
+					add_request (std::unique_ptr<nano::message> (request.release ()));
+				}
+				receive ();
 			}
+		}
+		else
+		{
+			node->stats.inc (nano::stat::type::filter, nano::stat::detail::duplicate_publish, nano::stat::dir::in);
 			receive ();
 		}
 	}
@@ -429,7 +439,7 @@ void nano::bootstrap_server::receive_confirm_req_action (boost::system::error_co
 	{
 		auto error (false);
 		nano::bufferstream stream (receive_buffer->data (), size_a);
-		auto request (std::make_unique<nano::confirm_req> (error, stream, header_a));
+		auto request (std::make_unique<nano::confirm_req> (error, stream, header_a, &node->block_uniquer));
 		if (!error)
 		{
 			if (is_realtime_connection ())
@@ -451,7 +461,7 @@ void nano::bootstrap_server::receive_confirm_ack_action (boost::system::error_co
 	{
 		auto error (false);
 		nano::bufferstream stream (receive_buffer->data (), size_a);
-		auto request (std::make_unique<nano::confirm_ack> (error, stream, header_a));
+		auto request (std::make_unique<nano::confirm_ack> (error, stream, header_a, &node->vote_uniquer));
 		if (!error)
 		{
 			if (is_realtime_connection ())
@@ -91,11 +91,14 @@ void nano::add_node_flag_options (boost::program_options::options_description &
 		("disable_udp", "Disables UDP realtime network")
 		("disable_unchecked_cleanup", "Disables periodic cleanup of old records from unchecked table")
 		("disable_unchecked_drop", "Disables drop of unchecked table at startup")
+		("disable_ledger_cache_snapshot", "Disables saving the ledger cache at shutdown and loading it at startup instead of scanning the ledger")
 		("fast_bootstrap", "Increase bootstrap speed for high end nodes with higher limits")
 		("batch_size", boost::program_options::value<std::size_t>(), "Increase sideband batch size, default 512")
 		("block_processor_batch_size", boost::program_options::value<std::size_t>(), "Increase block processor transaction batch write size, default 0 (limited by config block_processor_batch_max_time), 256k for fast_bootstrap")
 		("block_processor_full_size", boost::program_options::value<std::size_t>(), "Increase block processor allowed blocks queue size before dropping live network packets and holding bootstrap download, default 65536, 1 million for fast_bootstrap")
-		("block_processor_verification_size", boost::program_options::value<std::size_t>(), "Increase batch signature verification size in block processor, default 0 (limited by config signature_checker_threads), unlimited for fast_bootstrap");
+		("block_processor_verification_size", boost::program_options::value<std::size_t>(), "Increase batch signature verification size in block processor, default 0 (limited by config signature_checker_threads), unlimited for fast_bootstrap")
+		("signature_checker_batch_size", boost::program_options::value<std::size_t>(), "Number of signatures verified per signature checker thread task, default 256. Use debug_verify_profile_batch to find the best value for a CPU")
+		("unchecked_cache_size", boost::program_options::value<std::size_t>(), "Number of unchecked blocks held in memory before spilling to the database, default 65536");
 	// clang-format on
 }
 
@@ -120,6 +123,7 @@ std::error_code nano::update_flags (nano::node_flags & flags_a, boost::program_o
 	}
 	flags_a.disable_unchecked_cleanup = (vm.count ("disable_unchecked_cleanup") > 0);
 	flags_a.disable_unchecked_drop = (vm.count ("disable_unchecked_drop") > 0);
+	flags_a.disable_ledger_cache_snapshot = (vm.count ("disable_ledger_cache_snapshot") > 0);
 	flags_a.fast_bootstrap = (vm.count ("fast_bootstrap") > 0);
 	if (flags_a.fast_bootstrap)
 	{
@@ -142,6 +146,16 @@ std::error_code nano::update_flags (nano::node_flags & flags_a, boost::program_o
 	{
 		flags_a.block_processor_verification_size = block_processor_verification_size_it->second.as<size_t> ();
 	}
+	auto signature_checker_batch_size_it = vm.find ("signature_checker_batch_size");
+	if (signature_checker_batch_size_it != vm.end ())
+	{
+		flags_a.signature_checker_batch_size = std::max<size_t> (1, signature_checker_batch_size_it->second.as<size_t> ());
+	}
+	auto unchecked_cache_size_it = vm.find ("unchecked_cache_size");
+	if (unchecked_cache_size_it != vm.end ())
+	{
+		flags_a.unchecked_cache_size = unchecked_cache_size_it->second.as<size_t> ();
+	}
 	return ec;
 }
 
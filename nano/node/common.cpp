@@ -12,6 +12,7 @@
 
 std::bitset<16> constexpr nano::message_header::block_type_mask;
 std::bitset<16> constexpr nano::message_header::count_mask;
+size_t constexpr nano::confirm_ack::max_size;
 
 namespace
 {
@@ -306,6 +307,10 @@ std::string nano::message_parser::status_string ()
 		{
 			return "invalid_network";
 		}
+		case nano::message_parser::parse_status::duplicate_publish_message:
+		{
+			return "duplicate_publish_message";
+		}
 	}
 
 	assert (false);
@@ -313,7 +318,8 @@ std::string nano::message_parser::status_string ()
 	return "[unknown parse_status]";
 }
 
-nano::message_parser::message_parser (nano::block_uniquer & block_uniquer_a, nano::vote_uniquer & vote_uniquer_a, nano::message_visitor & visitor_a, nano::work_pool & pool_a) :
+nano::message_parser::message_parser (nano::network_filter & publish_filter_a, nano::block_uniquer & block_uniquer_a, nano::vote_uniquer & vote_uniquer_a, nano::message_visitor & visitor_a, nano::work_pool & pool_a) :
+publish_filter (publish_filter_a),
 block_uniquer (block_uniquer_a),
 vote_uniquer (vote_uniquer_a),
 visitor (visitor_a),
@@ -349,7 +355,17 @@ void nano::message_parser::deserialize_buffer (uint8_t const * buffer_a, size_t
 					}
 					case nano::message_type::publish:
 					{
-						deserialize_publish (stream, header);
+						// Republished blocks are dropped before deserializing by checking the payload against recently seen ones
+						nano::network_filter::digest_t digest (0);
+						auto payload_size (static_cast<size_t> (stream.in_avail ()));
+						if (!publish_filter.apply (buffer_a + size_a - payload_size, payload_size, &digest))
+						{
+							deserialize_publish (stream, header, digest);
+						}
+						else
+						{
+							status = parse_status::duplicate_publish_message;
+						}
 						break;
 					}
 					case nano::message_type::confirm_req:
@@ -406,10 +422,11 @@ void nano::message_parser::deserialize_keepalive (nano::stream & stream_a, nano:
 	}
 }
 
-void nano::message_parser::deserialize_publish (nano::stream & stream_a, nano::message_header const & header_a)
+void nano::message_parser::deserialize_publish (nano::stream & stream_a, nano::message_header const & header_a, nano::network_filter::digest_t const & digest_a)
 {
 	auto error (false);
 	nano::publish incoming (error, stream_a, header_a, &block_uniquer);
+	incoming.digest = digest_a;
 	if (!error && at_end (stream_a))
 	{
 		if (!nano::work_validate (*incoming.block))
@@ -769,12 +786,35 @@ size_t nano::confirm_req::size (nano::block_type type_a, size_t count)
 }
 
 nano::confirm_ack::confirm_ack (bool & error_a, nano::stream & stream_a, nano::message_header const & header_a, nano::vote_uniquer * uniquer_a) :
-message (header_a),
-vote (nano::make_shared<nano::vote> (error_a, stream_a, header.block_type ()))
+message (header_a)
 {
-	if (!error_a && uniquer_a)
+	if (uniquer_a != nullptr)
+	{
+		// Read the payload onto the stack and look the vote up by its hash first, so repeated votes are never deserialized
+		std::array<uint8_t, max_size> payload;
+		auto size (header.payload_length_bytes ());
+		error_a = size > payload.size () || static_cast<size_t> (stream_a.sgetn (payload.data (), size)) != size;
+		if (!error_a)
+		{
+			nano::block_hash full_hash;
+			if (!nano::vote::serialized_full_hash (header.block_type (), payload.data (), size, full_hash))
+			{
+				vote = uniquer_a->find (full_hash);
+			}
+			if (vote == nullptr)
+			{
+				nano::bufferstream payload_stream (payload.data (), size);
+				vote = nano::make_shared<nano::vote> (error_a, payload_stream, header.block_type ());
+				if (!error_a)
+				{
+					vote = uniquer_a->unique (vote);
+				}
+			}
+		}
+	}
+	else
 	{
-		vote = uniquer_a->unique (vote);
+		vote = nano::make_shared<nano::vote> (error_a, stream_a, header.block_type ());
 	}
 }
 
@@ -12,8 +12,8 @@
 
 #include <boost/optional.hpp>
 
+#include <algorithm>
 #include <cassert>
-#include <numeric>
 
 nano::confirmation_height_processor::confirmation_height_processor (nano::pending_confirmation_height & pending_confirmation_height_a, nano::ledger & ledger_a, nano::active_transactions & active_a, nano::write_database_queue & write_database_queue_a, std::chrono::milliseconds batch_separate_pending_min_time_a, nano::logger_mt & logger_a) :
 pending_confirmations (pending_confirmation_height_a),
@@ -60,6 +60,8 @@ void nano::confirmation_height_processor::run ()
 			{
 				// Separate blocks which are pending confirmation height can be batched by a minimum processing time (to improve disk write performance), so make sure the slate is clean when a new batch is starting.
 				confirmed_iterated_pairs.clear ();
+				election_callbacks.clear ();
+				update_container_sizes ();
 				timer.restart ();
 			}
 			add_confirmation_height (current_pending_block);
@@ -162,14 +164,8 @@ void nano::confirmation_height_processor::add_confirmation_height (nano::block_h
 
 		if (!last_iteration && current == hash_a && confirmation_height >= block_height)
 		{
-			auto it = std::find_if (pending_writes.begin (), pending_writes.end (), [&hash_a](auto & conf_height_details) {
-				auto it = std::find_if (conf_height_details.block_callbacks_required.begin (), conf_height_details.block_callbacks_required.end (), [&hash_a](auto & callback_data) {
-					return callback_data.block->hash () == hash_a;
-				});
-				return (it != conf_height_details.block_callbacks_required.end ());
-			});
-
-			if (it == pending_writes.end ())
+			// The original block is always recorded with a status type when collected, so it is only absent if no pending write will notify it
+			if (election_callbacks.find (hash_a) == election_callbacks.end ())
 			{
 				// This is a block which has been added to the processor but already has its confirmation height set (or about to be set)
 				// Just need to perform active cleanup, no callbacks are needed.
@@ -178,7 +174,6 @@ void nano::confirmation_height_processor::add_confirmation_height (nano::block_h
 		}
 
 		auto count_before_receive = receive_source_pairs.size ();
-		std::vector<callback_data> block_callbacks_required;
 		if (block_height > iterated_height)
 		{
 			if ((block_height - iterated_height) > 20000)
@@ -186,7 +181,7 @@ void nano::confirmation_height_processor::add_confirmation_height (nano::block_h
 				logger.always_log ("Iterating over a large account chain for setting confirmation height. The top block: ", current.to_string ());
 			}
 
-			collect_unconfirmed_receive_and_sources_for_account (block_height, iterated_height, current, account, read_transaction, block_callbacks_required);
+			collect_unconfirmed_receive_and_sources_for_account (block_height, iterated_height, current, account, read_transaction);
 		}
 
 		// Exit early when the processor has been stopped, otherwise this function may take a
@@ -220,7 +215,7 @@ void nano::confirmation_height_processor::add_confirmation_height (nano::block_h
 					confirmed_iterated_pairs.emplace (account, confirmed_iterated_pair{ block_height, block_height });
 				}
 
-				pending_writes.emplace_back (account, current, block_height, block_height - confirmation_height, block_callbacks_required);
+				pending_writes.emplace_back (account, current, block_height, block_height - confirmation_height);
 			}
 
 			if (receive_details)
@@ -284,6 +279,7 @@ void nano::confirmation_height_processor::add_confirmation_height (nano::block_h
 			}
 		}
 
+		update_container_sizes ();
 		read_transaction.renew ();
 	} while (!receive_source_pairs.empty () || current != hash_a);
 }
@@ -293,18 +289,16 @@ void nano::confirmation_height_processor::add_confirmation_height (nano::block_h
  */
 bool nano::confirmation_height_processor::write_pending (std::deque<conf_height_details> & all_pending_a)
 {
-	auto total_pending_write_block_count = std::accumulate (all_pending_a.cbegin (), all_pending_a.cend (), uint64_t (0), [](uint64_t total, conf_height_details const & conf_height_details_a) {
-		return total += conf_height_details_a.num_blocks_confirmed;
-	});
-
 	// Write in batches
-	while (total_pending_write_block_count > 0)
+	while (!all_pending_a.empty ())
 	{
 		uint64_t num_accounts_processed = 0;
+		uint64_t num_blocks_cemented = 0;
 		auto transaction (ledger.store.tx_begin_write ({}, { nano::tables::confirmation_height }));
-		while (!all_pending_a.empty ())
+		// Commit changes periodically to reduce time holding write locks for long chains
+		while (!all_pending_a.empty () && num_accounts_processed < batch_write_size && num_blocks_cemented < batch_cement_size)
 		{
-			const auto & pending = all_pending_a.front ();
+			auto & pending = all_pending_a.front ();
 			nano::confirmation_height_info confirmation_height_info;
 			auto error = ledger.store.confirmation_height_get (transaction, pending.account, confirmation_height_info);
 			release_assert (!error);
@@ -329,36 +323,82 @@ bool nano::confirmation_height_processor::write_pending (std::deque<conf_height_
 					receive_source_pairs.clear ();
 					receive_source_pairs_size = 0;
 					all_pending_a.clear ();
+					election_callbacks.clear ();
+					update_container_sizes ();
 					return true;
 				}
 
-				for (auto & callback_data : pending.block_callbacks_required)
+				assert (pending.num_blocks_confirmed == pending.height - confirmation_height);
+				auto num_to_cement (std::min (pending.height - confirmation_height, batch_cement_size - num_blocks_cemented));
+				cement (transaction, pending.account, confirmation_height_info, num_to_cement);
+				num_blocks_cemented += num_to_cement;
+				pending.num_blocks_confirmed -= num_to_cement;
+				if (confirmation_height_info.height < pending.height)
 				{
-					active.post_confirmation_height_set (transaction, callback_data.block, callback_data.sideband, callback_data.election_status_type);
+					// The rest of this chain is cemented in the next transaction
+					continue;
 				}
-
-				ledger.stats.add (nano::stat::type::confirmation_height, nano::stat::detail::blocks_confirmed, nano::stat::dir::in, pending.height - confirmation_height);
-				assert (pending.num_blocks_confirmed == pending.height - confirmation_height);
-				confirmation_height = pending.height;
-				ledger.cache.cemented_count += pending.num_blocks_confirmed;
-				ledger.store.confirmation_height_put (transaction, pending.account, { confirmation_height, pending.hash });
+				assert (confirmation_height_info.frontier == pending.hash);
 			}
-			total_pending_write_block_count -= pending.num_blocks_confirmed;
 			++num_accounts_processed;
-			all_pending_a.erase (all_pending_a.begin ());
+			all_pending_a.pop_front ();
+		}
+		update_container_sizes ();
+	}
+	return false;
+}
 
-			if (num_accounts_processed >= batch_write_size)
+void nano::confirmation_height_processor::update_container_sizes ()
+{
+	pending_writes_size = pending_writes.size ();
+	election_callbacks_size = election_callbacks.size ();
+}
+
+/*
+ * Cements the next \p num_to_cement blocks above the account's confirmation height in ascending order, notifying observers of each
+ * block as it is reached rather than collecting them beforehand. \p confirmation_height_info is updated to the new confirmation height.
+ */
+void nano::confirmation_height_processor::cement (nano::write_transaction const & transaction_a, nano::account const & account_a, nano::confirmation_height_info & confirmation_height_info_a, uint64_t num_to_cement_a)
+{
+	nano::block_hash hash;
+	if (confirmation_height_info_a.height == 0)
+	{
+		nano::account_info account_info;
+		auto error (ledger.store.account_get (transaction_a, account_a, account_info));
+		release_assert (!error);
+		hash = account_info.open_block;
+	}
+	else
+	{
+		hash = ledger.store.block_successor (transaction_a, confirmation_height_info_a.frontier);
+	}
+	for (uint64_t i (0); i < num_to_cement_a; ++i)
+	{
+		nano::block_sideband sideband;
+		auto block (ledger.store.block_get (transaction_a, hash, &sideband));
+		release_assert (block != nullptr);
+		auto existing (election_callbacks.find (hash));
+		if (existing == election_callbacks.end ())
+		{
+			active.post_confirmation_height_set (transaction_a, block, sideband, nano::election_status_type::inactive_confirmation_height);
+		}
+		else
+		{
+			if (existing->second.is_initialized ())
 			{
-				// Commit changes periodically to reduce time holding write locks for long chains
-				break;
+				active.post_confirmation_height_set (transaction_a, block, sideband, *existing->second);
 			}
+			election_callbacks.erase (existing);
 		}
+		confirmation_height_info_a = { sideband.height, hash };
+		hash = sideband.successor;
 	}
-	assert (all_pending_a.empty ());
-	return false;
+	ledger.stats.add (nano::stat::type::confirmation_height, nano::stat::detail::blocks_confirmed, nano::stat::dir::in, num_to_cement_a);
+	ledger.cache.cemented_count += num_to_cement_a;
+	ledger.store.confirmation_height_put (transaction_a, account_a, confirmation_height_info_a);
 }
 
-void nano::confirmation_height_processor::collect_unconfirmed_receive_and_sources_for_account (uint64_t block_height_a, uint64_t confirmation_height_a, nano::block_hash const & hash_a, nano::account const & account_a, nano::read_transaction const & transaction_a, std::vector<callback_data> & block_callbacks_required)
+void nano::confirmation_height_processor::collect_unconfirmed_receive_and_sources_for_account (uint64_t block_height_a, uint64_t confirmation_height_a, nano::block_hash const & hash_a, nano::account const & account_a, nano::read_transaction const & transaction_a)
 {
 	auto hash (hash_a);
 	auto num_to_confirm = block_height_a - confirmation_height_a;
@@ -375,15 +415,15 @@ void nano::confirmation_height_processor::collect_unconfirmed_receive_and_source
 			if (!pending_confirmations.is_processing_block (hash))
 			{
 				auto election_status_type = active.confirm_block (transaction_a, block);
-				if (election_status_type.is_initialized ())
+				if (!election_status_type.is_initialized () || *election_status_type != nano::election_status_type::inactive_confirmation_height)
 				{
-					block_callbacks_required.emplace_back (block, sideband, *election_status_type);
+					election_callbacks.emplace (hash, election_status_type);
 				}
 			}
 			else
 			{
 				// This block is the original which is having its confirmation height set on
-				block_callbacks_required.emplace_back (block, sideband, nano::election_status_type::active_confirmed_quorum);
+				election_callbacks.emplace (hash, nano::election_status_type::active_confirmed_quorum);
 			}
 
 			auto source (block->source ());
@@ -399,15 +439,9 @@ void nano::confirmation_height_processor::collect_unconfirmed_receive_and_source
 				if (next_height != height_not_set)
 				{
 					receive_source_pairs.back ().receive_details.num_blocks_confirmed = next_height - block_height;
-
-					auto & receive_callbacks_required = receive_source_pairs.back ().receive_details.block_callbacks_required;
-
-					// Don't include the last one as that belongs to the next recieve
-					std::copy (block_callbacks_required.begin (), block_callbacks_required.end () - 1, std::back_inserter (receive_callbacks_required));
-					block_callbacks_required = { block_callbacks_required.back () };
 				}
 
-				receive_source_pairs.emplace_back (conf_height_details{ account_a, hash, block_height, height_not_set, {} }, source);
+				receive_source_pairs.emplace_back (conf_height_details{ account_a, hash, block_height, height_not_set }, source);
 				++receive_source_pairs_size;
 				next_height = block_height;
 			}
@@ -429,16 +463,14 @@ void nano::confirmation_height_processor::collect_unconfirmed_receive_and_source
 	{
 		auto & last_receive_details = receive_source_pairs.back ().receive_details;
 		last_receive_details.num_blocks_confirmed = last_receive_details.height - confirmation_height_a;
-		last_receive_details.block_callbacks_required = block_callbacks_required;
 	}
 }
 
-nano::confirmation_height_processor::conf_height_details::conf_height_details (nano::account const & account_a, nano::block_hash const & hash_a, uint64_t height_a, uint64_t num_blocks_confirmed_a, std::vector<callback_data> const & block_callbacks_required_a) :
+nano::confirmation_height_processor::conf_height_details::conf_height_details (nano::account const & account_a, nano::block_hash const & hash_a, uint64_t height_a, uint64_t num_blocks_confirmed_a) :
 account (account_a),
 hash (hash_a),
 height (height_a),
-num_blocks_confirmed (num_blocks_confirmed_a),
-block_callbacks_required (block_callbacks_required_a)
+num_blocks_confirmed (num_blocks_confirmed_a)
 {
 }
 
@@ -453,18 +485,15 @@ confirmed_height (confirmed_height_a), iterated_height (iterated_height_a)
 {
 }
 
-nano::confirmation_height_processor::callback_data::callback_data (std::shared_ptr<nano::block> const & block_a, nano::block_sideband const & sideband_a, nano::election_status_type election_status_type_a) :
-block (block_a),
-sideband (sideband_a),
-election_status_type (election_status_type_a)
-{
-}
-
 std::unique_ptr<nano::container_info_component> nano::collect_container_info (confirmation_height_processor & confirmation_height_processor_a, const std::string & name_a)
 {
 	size_t receive_source_pairs_count = confirmation_height_processor_a.receive_source_pairs_size;
 	auto composite = std::make_unique<container_info_composite> (name_a);
+	size_t pending_writes_count = confirmation_height_processor_a.pending_writes_size;
+	size_t election_callbacks_count = confirmation_height_processor_a.election_callbacks_size;
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "receive_source_pairs", receive_source_pairs_count, sizeof (decltype (confirmation_height_processor_a.receive_source_pairs)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "pending_writes", pending_writes_count, sizeof (decltype (confirmation_height_processor_a.pending_writes)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "election_callbacks", election_callbacks_count, sizeof (decltype (confirmation_height_processor_a.election_callbacks)::value_type) }));
 	return composite;
 }
 
@@ -5,6 +5,8 @@
 #include <nano/secure/blockstore.hpp>
 #include <nano/secure/common.hpp>
 
+#include <boost/optional.hpp>
+
 #include <condition_variable>
 #include <mutex>
 #include <thread>
@@ -54,26 +56,19 @@ public:
 	/** The maximum number of blocks to be read in while iterating over a long account chain */
 	static uint64_t constexpr batch_read_size = 4096;
 
-private:
-	class callback_data final
-	{
-	public:
-		callback_data (std::shared_ptr<nano::block> const &, nano::block_sideband const &, nano::election_status_type);
-		std::shared_ptr<nano::block> block;
-		nano::block_sideband sideband;
-		nano::election_status_type election_status_type;
-	};
+	/** The maximum number of blocks to cement in a single write transaction, long chains are cemented in ranges of this size */
+	static uint64_t constexpr batch_cement_size = 65536;
 
+private:
 	class conf_height_details final
 	{
 	public:
-		conf_height_details (nano::account const &, nano::block_hash const &, uint64_t, uint64_t, std::vector<callback_data> const &);
+		conf_height_details (nano::account const &, nano::block_hash const &, uint64_t, uint64_t);
 
 		nano::account account;
 		nano::block_hash hash;
 		uint64_t height;
 		uint64_t num_blocks_confirmed;
-		std::vector<callback_data> block_callbacks_required;
 	};
 
 	class receive_source_pair final
@@ -107,6 +102,12 @@ private:
 	// Store the highest confirmation heights for accounts in pending_writes to reduce unnecessary iterating,
 	// and iterated height to prevent iterating over the same blocks more than once from self-sends or "circular" sends between the same accounts.
 	std::unordered_map<account, confirmed_iterated_pair> confirmed_iterated_pairs;
+	// Status types for pending blocks which were part of an election or are the block originally requested, no callback is made for those mapped to none.
+	// Every other cemented block is notified as inactive_confirmation_height while it is written, so nothing is kept in memory for it.
+	std::unordered_map<nano::block_hash, boost::optional<nano::election_status_type>> election_callbacks;
+	/** Sizes of pending_writes and election_callbacks, which are only accessed by the processing thread, for reporting */
+	std::atomic<uint64_t> pending_writes_size{ 0 };
+	std::atomic<uint64_t> election_callbacks_size{ 0 };
 	nano::timer<std::chrono::milliseconds> timer;
 	nano::write_database_queue & write_database_queue;
 	std::chrono::milliseconds batch_separate_pending_min_time;
@@ -114,11 +115,14 @@ private:
 
 	void run ();
 	void add_confirmation_height (nano::block_hash const &);
-	void collect_unconfirmed_receive_and_sources_for_account (uint64_t, uint64_t, nano::block_hash const &, nano::account const &, nano::read_transaction const &, std::vector<callback_data> &);
+	void collect_unconfirmed_receive_and_sources_for_account (uint64_t, uint64_t, nano::block_hash const &, nano::account const &, nano::read_transaction const &);
 	bool write_pending (std::deque<conf_height_details> &);
+	void cement (nano::write_transaction const &, nano::account const &, nano::confirmation_height_info &, uint64_t);
+	void update_container_sizes ();
 
 	friend std::unique_ptr<container_info_component> collect_container_info (confirmation_height_processor &, const std::string &);
 	friend class confirmation_height_pending_observer_callbacks_Test;
+	friend class confirmation_height_very_long_chain_Test;
 };
 
 std::unique_ptr<container_info_component> collect_container_info (confirmation_height_processor &, const std::string &);
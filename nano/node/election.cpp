@@ -16,9 +16,11 @@ election_start (std::chrono::steady_clock::now ()),
 status ({ block_a, 0, std::chrono::duration_cast<std::chrono::milliseconds> (std::chrono::system_clock::now ().time_since_epoch ()), std::chrono::duration_values<std::chrono::milliseconds>::zero (), 0, 1, 0, nano::election_status_type::ongoing }),
 skip_delay (skip_delay_a),
 confirmed (false),
-stopped (false)
+stopped (false),
+last_weights_refresh (election_start)
 {
 	last_votes.emplace (node.network_params.random.not_an_account, nano::vote_info{ std::chrono::steady_clock::now (), 0, block_a->hash () });
+	tally_add (node.network_params.random.not_an_account, block_a->hash (), rep_weight (node.network_params.random.not_an_account));
 	blocks.emplace (block_a->hash (), block_a);
 	update_dependent ();
 }
@@ -80,14 +82,12 @@ bool nano::election::have_quorum (nano::tally_t const & tally_a, nano::uint128_t
 
 nano::tally_t nano::election::tally ()
 {
-	std::unordered_map<nano::block_hash, nano::uint128_t> block_weights;
-	for (auto vote_info : last_votes)
+	if (std::chrono::steady_clock::now () - last_weights_refresh >= weights_refresh_interval)
 	{
-		block_weights[vote_info.second.hash] += node.ledger.weight (vote_info.first);
+		refresh_weights ();
 	}
-	last_tally = block_weights;
 	nano::tally_t result;
-	for (auto item : block_weights)
+	for (auto & item : last_tally)
 	{
 		auto block (blocks.find (item.first));
 		if (block != blocks.end ())
@@ -98,6 +98,49 @@ nano::tally_t nano::election::tally ()
 	return result;
 }
 
+void nano::election::refresh_weights ()
+{
+	weights.clear ();
+	last_tally.clear ();
+	last_tally_voters.clear ();
+	for (auto & vote_info : last_votes)
+	{
+		tally_add (vote_info.first, vote_info.second.hash, node.ledger.weight (vote_info.first));
+	}
+	last_weights_refresh = std::chrono::steady_clock::now ();
+}
+
+nano::uint128_t nano::election::rep_weight (nano::account const & rep_a) const
+{
+	auto existing (weights.find (rep_a));
+	return existing != weights.end () ? existing->second : node.ledger.weight (rep_a);
+}
+
+void nano::election::tally_add (nano::account const & rep_a, nano::block_hash const & hash_a, nano::uint128_t const & weight_a)
+{
+	auto weight (weights.emplace (rep_a, weight_a).first->second);
+	last_tally[hash_a] += weight;
+	++last_tally_voters[hash_a];
+}
+
+void nano::election::tally_remove (nano::account const & rep_a, nano::block_hash const & hash_a)
+{
+	auto voters (last_tally_voters.find (hash_a));
+	auto weight (weights.find (rep_a));
+	if (voters != last_tally_voters.end () && weight != weights.end ())
+	{
+		if (--voters->second == 0)
+		{
+			last_tally_voters.erase (voters);
+			last_tally.erase (hash_a);
+		}
+		else
+		{
+			last_tally[hash_a] -= weight->second;
+		}
+	}
+}
+
 void nano::election::confirm_if_quorum ()
 {
 	auto tally_l (tally ());
@@ -149,7 +192,7 @@ nano::election_vote_result nano::election::vote (nano::account rep, uint64_t seq
 	// see republish_vote documentation for an explanation of these rules
 	auto replay (false);
 	auto online_stake (node.online_reps.online_stake ());
-	auto weight (node.ledger.weight (rep));
+	auto weight (rep_weight (rep));
 	auto should_process (false);
 	if (node.network_params.network.is_test_network () || weight > node.minimum_principal_weight (online_stake))
 	{
@@ -189,7 +232,14 @@ nano::election_vote_result nano::election::vote (nano::account rep, uint64_t seq
 		if (should_process)
 		{
 			node.stats.inc (nano::stat::type::election, nano::stat::detail::vote_new);
-			last_votes[rep] = { std::chrono::steady_clock::now (), sequence, block_hash };
+			nano::vote_info info{ std::chrono::steady_clock::now (), sequence, block_hash };
+			auto inserted (last_votes.emplace (rep, info));
+			if (!inserted.second)
+			{
+				tally_remove (rep, inserted.first->second.hash);
+				inserted.first->second = info;
+			}
+			tally_add (rep, block_hash, weight);
 			if (!confirmed)
 			{
 				confirm_if_quorum ();
@@ -199,12 +249,19 @@ nano::election_vote_result nano::election::vote (nano::account rep, uint64_t seq
 	return nano::election_vote_result (replay, should_process);
 }
 
+bool nano::election::replay (nano::account const & rep_a, uint64_t sequence_a, nano::block_hash const & hash_a) const
+{
+	auto existing (last_votes.find (rep_a));
+	return existing != last_votes.end () && !(existing->second.sequence < sequence_a || (existing->second.sequence == sequence_a && existing->second.hash < hash_a));
+}
+
 bool nano::election::publish (std::shared_ptr<nano::block> block_a)
 {
 	auto result (false);
 	if (blocks.size () >= 10)
 	{
-		if (last_tally[block_a->hash ()] < node.online_reps.online_stake () / 10)
+		auto existing (last_tally.find (block_a->hash ()));
+		if (existing == last_tally.end () || existing->second < node.online_reps.online_stake () / 10)
 		{
 			result = true;
 		}
@@ -305,6 +362,7 @@ void nano::election::insert_inactive_votes_cache (nano::block_hash const & hash_
 		auto inserted (last_votes.emplace (rep, nano::vote_info{ std::chrono::steady_clock::time_point::min (), 0, hash_a }));
 		if (inserted.second)
 		{
+			tally_add (rep, hash_a, rep_weight (rep));
 			node.stats.inc (nano::stat::type::election, nano::stat::detail::vote_cached);
 		}
 	}
@@ -51,11 +51,18 @@ public:
 class election final : public std::enable_shared_from_this<nano::election>
 {
 	std::function<void(std::shared_ptr<nano::block>)> confirmation_action;
+	nano::uint128_t rep_weight (nano::account const &) const;
+	void tally_add (nano::account const &, nano::block_hash const &, nano::uint128_t const &);
+	void tally_remove (nano::account const &, nano::block_hash const &);
 
 public:
 	election (nano::node &, std::shared_ptr<nano::block>, bool const, std::function<void(std::shared_ptr<nano::block>)> const &);
 	nano::election_vote_result vote (nano::account, uint64_t, nano::block_hash);
+	// Check if a vote would be rejected as a replay of one already counted
+	bool replay (nano::account const &, uint64_t, nano::block_hash const &) const;
 	nano::tally_t tally ();
+	// Recompute the tally from scratch with current representative weights
+	void refresh_weights ();
 	// Check if we have vote quorum
 	bool have_quorum (nano::tally_t const &, nano::uint128_t) const;
 	void confirm_once (nano::election_status_type = nano::election_status_type::active_confirmed_quorum);
@@ -77,11 +84,17 @@ public:
 	bool skip_delay;
 	std::atomic<bool> confirmed;
 	bool stopped;
+	// Running tally per block, updated as votes arrive or are replaced
 	std::unordered_map<nano::block_hash, nano::uint128_t> last_tally;
+	std::unordered_map<nano::block_hash, size_t> last_tally_voters;
+	// Representative weights as of the last refresh, used for every vote in between
+	std::unordered_map<nano::account, nano::uint128_t> weights;
 	unsigned confirmation_request_count{ 0 };
 	std::chrono::steady_clock::time_point last_broadcast;
 	std::chrono::steady_clock::time_point last_request;
 	std::unordered_set<nano::block_hash> dependent_blocks;
 	std::chrono::seconds late_blocks_delay{ 5 };
+	std::chrono::steady_clock::time_point last_weights_refresh;
+	std::chrono::seconds weights_refresh_interval{ 60 };
 };
 }
@@ -1,5 +1,6 @@
 #include <nano/lib/config.hpp>
 #include <nano/lib/json_error_response.hpp>
+#include <nano/lib/json_writer.hpp>
 #include <nano/lib/timer.hpp>
 #include <nano/node/common.hpp>
 #include <nano/node/election.hpp>
@@ -140,6 +141,18 @@ void nano::json_handler::response_errors ()
 	}
 }
 
+void nano::json_handler::response_json (nano::json_writer & writer_a)
+{
+	if (ec)
+	{
+		response_errors ();
+	}
+	else
+	{
+		response (writer_a.str ());
+	}
+}
+
 std::shared_ptr<nano::wallet> nano::json_handler::wallet_impl ()
 {
 	if (!ec)
@@ -2280,17 +2293,19 @@ void nano::json_handler::frontiers ()
 {
 	auto start (account_impl ());
 	auto count (count_impl ());
+	nano::json_writer writer;
 	if (!ec)
 	{
-		boost::property_tree::ptree frontiers;
+		writer.begin_object ("frontiers");
+		uint64_t written (0);
 		auto transaction (node.store.tx_begin_read ());
-		for (auto i (node.store.latest_begin (transaction, start)), n (node.store.latest_end ()); i != n && frontiers.size () < count; ++i)
+		for (auto i (node.store.latest_begin (transaction, start)), n (node.store.latest_end ()); i != n && written < count; ++i, ++written)
 		{
-			frontiers.put (i->first.to_account (), i->second.head.to_string ());
+			writer.put (i->first.to_account (), i->second.head.to_string ());
 		}
-		response_l.add_child ("frontiers", frontiers);
+		writer.end ();
 	}
-	response_errors ();
+	response_json (writer);
 }
 
 void nano::json_handler::account_count ()
@@ -2534,11 +2549,12 @@ void nano::json_handler::account_history ()
 			}
 		}
 	}
+	nano::json_writer writer;
 	if (!ec)
 	{
-		boost::property_tree::ptree history;
 		bool output_raw (request.get_optional<bool> ("raw") == true);
-		response_l.put ("account", account.to_account ());
+		writer.put ("account", account.to_account ());
+		writer.begin_array ("history");
 		nano::block_sideband sideband;
 		auto block (node.store.block_get (transaction, hash, &sideband));
 		while (block != nullptr && count > 0)
@@ -2562,20 +2578,20 @@ void nano::json_handler::account_history ()
 						entry.put ("work", nano::to_string_hex (block->block_work ()));
 						entry.put ("signature", block->block_signature ().to_string ());
 					}
-					history.push_back (std::make_pair ("", entry));
+					writer.put_tree ("", entry);
 					--count;
 				}
 			}
 			hash = reverse ? node.store.block_successor (transaction, hash) : block->previous ();
 			block = node.store.block_get (transaction, hash, &sideband);
 		}
-		response_l.add_child ("history", history);
+		writer.end ();
 		if (!hash.is_zero ())
 		{
-			response_l.put (reverse ? "next" : "previous", hash.to_string ());
+			writer.put (reverse ? "next" : "previous", hash.to_string ());
 		}
 	}
-	response_errors ();
+	response_json (writer);
 }
 
 void nano::json_handler::keepalive ()
@@ -2629,6 +2645,7 @@ void nano::json_handler::ledger ()
 {
 	auto count (count_optional_impl ());
 	auto threshold (threshold_optional_impl ());
+	nano::json_writer writer;
 	if (!ec)
 	{
 		nano::account start (0);
@@ -2650,44 +2667,50 @@ void nano::json_handler::ledger ()
 		const bool representative = request.get<bool> ("representative", false);
 		const bool weight = request.get<bool> ("weight", false);
 		const bool pending = request.get<bool> ("pending", false);
-		boost::property_tree::ptree accounts;
+		writer.begin_object ("accounts");
+		uint64_t written (0);
 		auto transaction (node.store.tx_begin_read ());
 		if (!ec && !sorting) // Simple
 		{
-			for (auto i (node.store.latest_begin (transaction, start)), n (node.store.latest_end ()); i != n && accounts.size () < count; ++i)
+			for (auto i (node.store.latest_begin (transaction, start)), n (node.store.latest_end ()); i != n && written < count; ++i)
 			{
 				nano::account_info const & info (i->second);
 				if (info.modified >= modified_since && (pending || info.balance.number () >= threshold.number ()))
 				{
 					nano::account const & account (i->first);
-					boost::property_tree::ptree response_a;
+					nano::uint128_t account_pending (0);
 					if (pending)
 					{
-						auto account_pending (node.ledger.account_pending (transaction, account));
+						account_pending = node.ledger.account_pending (transaction, account);
 						if (info.balance.number () + account_pending < threshold.number ())
 						{
 							continue;
 						}
-						response_a.put ("pending", account_pending.convert_to<std::string> ());
 					}
-					response_a.put ("frontier", info.head.to_string ());
-					response_a.put ("open_block", info.open_block.to_string ());
-					response_a.put ("representative_block", node.ledger.representative (transaction, info.head).to_string ());
+					writer.begin_object (account.to_account ());
+					if (pending)
+					{
+						writer.put ("pending", account_pending.convert_to<std::string> ());
+					}
+					writer.put ("frontier", info.head.to_string ());
+					writer.put ("open_block", info.open_block.to_string ());
+					writer.put ("representative_block", node.ledger.representative (transaction, info.head).to_string ());
 					std::string balance;
 					nano::uint128_union (info.balance).encode_dec (balance);
-					response_a.put ("balance", balance);
-					response_a.put ("modified_timestamp", std::to_string (info.modified));
-					response_a.put ("block_count", std::to_string (info.block_count));
+					writer.put ("balance", balance);
+					writer.put ("modified_timestamp", std::to_string (info.modified));
+					writer.put ("block_count", std::to_string (info.block_count));
 					if (representative)
 					{
-						response_a.put ("representative", info.representative.to_account ());
+						writer.put ("representative", info.representative.to_account ());
 					}
 					if (weight)
 					{
 						auto account_weight (node.ledger.weight (account));
-						response_a.put ("weight", account_weight.convert_to<std::string> ());
+						writer.put ("weight", account_weight.convert_to<std::string> ());
 					}
-					accounts.push_back (std::make_pair (account.to_account (), response_a));
+					writer.end ();
+					++written;
 				}
 			}
 		}
@@ -2706,46 +2729,51 @@ void nano::json_handler::ledger ()
 			std::sort (ledger_l.begin (), ledger_l.end ());
 			std::reverse (ledger_l.begin (), ledger_l.end ());
 			nano::account_info info;
-			for (auto i (ledger_l.begin ()), n (ledger_l.end ()); i != n && accounts.size () < count; ++i)
+			for (auto i (ledger_l.begin ()), n (ledger_l.end ()); i != n && written < count; ++i)
 			{
 				node.store.account_get (transaction, i->second, info);
 				if (pending || info.balance.number () >= threshold.number ())
 				{
 					nano::account const & account (i->second);
-					boost::property_tree::ptree response_a;
+					nano::uint128_t account_pending (0);
 					if (pending)
 					{
-						auto account_pending (node.ledger.account_pending (transaction, account));
+						account_pending = node.ledger.account_pending (transaction, account);
 						if (info.balance.number () + account_pending < threshold.number ())
 						{
 							continue;
 						}
-						response_a.put ("pending", account_pending.convert_to<std::string> ());
 					}
-					response_a.put ("frontier", info.head.to_string ());
-					response_a.put ("open_block", info.open_block.to_string ());
-					response_a.put ("representative_block", node.ledger.representative (transaction, info.head).to_string ());
+					writer.begin_object (account.to_account ());
+					if (pending)
+					{
+						writer.put ("pending", account_pending.convert_to<std::string> ());
+					}
+					writer.put ("frontier", info.head.to_string ());
+					writer.put ("open_block", info.open_block.to_string ());
+					writer.put ("representative_block", node.ledger.representative (transaction, info.head).to_string ());
 					std::string balance;
 					(i->first).encode_dec (balance);
-					response_a.put ("balance", balance);
-					response_a.put ("modified_timestamp", std::to_string (info.modified));
-					response_a.put ("block_count", std::to_string (info.block_count));
+					writer.put ("balance", balance);
+					writer.put ("modified_timestamp", std::to_string (info.modified));
+					writer.put ("block_count", std::to_string (info.block_count));
 					if (representative)
 					{
-						response_a.put ("representative", info.representative.to_account ());
+						writer.put ("representative", info.representative.to_account ());
 					}
 					if (weight)
 					{
 						auto account_weight (node.ledger.weight (account));
-						response_a.put ("weight", account_weight.convert_to<std::string> ());
+						writer.put ("weight", account_weight.convert_to<std::string> ());
 					}
-					accounts.push_back (std::make_pair (account.to_account (), response_a));
+					writer.end ();
+					++written;
 				}
 			}
 		}
-		response_l.add_child ("accounts", accounts);
+		writer.end ();
 	}
-	response_errors ();
+	response_json (writer);
 }
 
 void nano::json_handler::mnano_from_raw (nano::uint128_t ratio)
@@ -2909,66 +2937,72 @@ void nano::json_handler::pending ()
 	const bool include_only_confirmed = request.get<bool> ("include_only_confirmed", false);
 	const bool sorting = request.get<bool> ("sorting", false);
 	auto simple (threshold.is_zero () && !source && !min_version && !sorting); // if simple, response is a list of hashes
+	nano::json_writer writer;
 	if (!ec)
 	{
-		boost::property_tree::ptree peers_l;
+		std::vector<std::pair<nano::block_hash, nano::pending_info>> sorted;
+		uint64_t written (0);
+		if (simple)
+		{
+			writer.begin_array ("blocks");
+		}
+		else
+		{
+			writer.begin_object ("blocks");
+		}
 		auto transaction (node.store.tx_begin_read ());
-		for (auto i (node.store.pending_begin (transaction, nano::pending_key (account, 0))), n (node.store.pending_end ()); i != n && nano::pending_key (i->first).account == account && peers_l.size () < count; ++i)
+		for (auto i (node.store.pending_begin (transaction, nano::pending_key (account, 0))), n (node.store.pending_end ()); i != n && nano::pending_key (i->first).account == account && written < count; ++i)
 		{
 			nano::pending_key const & key (i->first);
 			if (block_confirmed (node, transaction, key.hash, include_active, include_only_confirmed))
 			{
 				if (simple)
 				{
-					boost::property_tree::ptree entry;
-					entry.put ("", key.hash.to_string ());
-					peers_l.push_back (std::make_pair ("", entry));
+					writer.put ("", key.hash.to_string ());
+					++written;
 				}
 				else
 				{
 					nano::pending_info const & info (i->second);
 					if (info.amount.number () >= threshold.number ())
 					{
-						if (source || min_version)
-						{
-							boost::property_tree::ptree pending_tree;
-							pending_tree.put ("amount", info.amount.number ().convert_to<std::string> ());
-							if (source)
-							{
-								pending_tree.put ("source", info.source.to_account ());
-							}
-							if (min_version)
-							{
-								pending_tree.put ("min_version", epoch_as_string (info.epoch));
-							}
-							peers_l.add_child (key.hash.to_string (), pending_tree);
-						}
-						else
-						{
-							peers_l.put (key.hash.to_string (), info.amount.number ().convert_to<std::string> ());
-						}
+						sorted.emplace_back (key.hash, info);
+						++written;
 					}
 				}
 			}
 		}
-		if (sorting && !simple)
+		if (sorting)
 		{
+			std::stable_sort (sorted.begin (), sorted.end (), [](auto const & lhs, auto const & rhs) {
+				return lhs.second.amount.number () > rhs.second.amount.number ();
+			});
+		}
+		for (auto const & item : sorted)
+		{
+			nano::pending_info const & info (item.second);
 			if (source || min_version)
 			{
-				peers_l.sort ([](const auto & child1, const auto & child2) -> bool {
-					return child1.second.template get<nano::uint128_t> ("amount") > child2.second.template get<nano::uint128_t> ("amount");
-				});
+				writer.begin_object (item.first.to_string ());
+				writer.put ("amount", info.amount.number ().convert_to<std::string> ());
+				if (source)
+				{
+					writer.put ("source", info.source.to_account ());
+				}
+				if (min_version)
+				{
+					writer.put ("min_version", epoch_as_string (info.epoch));
+				}
+				writer.end ();
 			}
 			else
 			{
-				peers_l.sort ([](const auto & child1, const auto & child2) -> bool {
-					return child1.second.template get<nano::uint128_t> ("") > child2.second.template get<nano::uint128_t> ("");
-				});
+				writer.put (item.first.to_string (), info.amount.number ().convert_to<std::string> ());
 			}
 		}
-		response_l.add_child ("blocks", peers_l);
+		writer.end ();
 	}
-	response_errors ();
+	response_json (writer);
 }
 
 void nano::json_handler::pending_exists ()
@@ -4023,29 +4057,30 @@ void nano::json_handler::unchecked ()
 {
 	const bool json_block_l = request.get<bool> ("json_block", false);
 	auto count (count_optional_impl ());
+	nano::json_writer writer;
 	if (!ec)
 	{
-		boost::property_tree::ptree unchecked;
+		writer.begin_object ("blocks");
+		uint64_t written (0);
 		auto transaction (node.store.tx_begin_read ());
-		for (auto i (node.store.unchecked_begin (transaction)), n (node.store.unchecked_end ()); i != n && unchecked.size () < count; ++i)
-		{
-			nano::unchecked_info const & info (i->second);
+		node.unchecked.for_each (transaction, [&writer, &written, count, json_block_l](nano::unchecked_key const &, nano::unchecked_info const & info) {
 			if (json_block_l)
 			{
 				boost::property_tree::ptree block_node_l;
 				info.block->serialize_json (block_node_l);
-				unchecked.add_child (info.block->hash ().to_string (), block_node_l);
+				writer.put_tree (info.block->hash ().to_string (), block_node_l);
 			}
 			else
 			{
 				std::string contents;
 				info.block->serialize_json (contents);
-				unchecked.put (info.block->hash ().to_string (), contents);
+				writer.put (info.block->hash ().to_string (), contents);
 			}
-		}
-		response_l.add_child ("blocks", unchecked);
+			return ++written < count;
+		});
+		writer.end ();
 	}
-	response_errors ();
+	response_json (writer);
 }
 
 void nano::json_handler::unchecked_clear ()
@@ -4053,7 +4088,7 @@ void nano::json_handler::unchecked_clear ()
 	auto rpc_l (shared_from_this ());
 	node.worker.push_task ([rpc_l]() {
 		auto transaction (rpc_l->node.store.tx_begin_write ());
-		rpc_l->node.store.unchecked_clear (transaction);
+		rpc_l->node.unchecked.clear (transaction);
 		rpc_l->node.ledger.cache.unchecked_count = 0;
 		rpc_l->response_l.put ("success", "");
 		rpc_l->response_errors ();
@@ -4067,12 +4102,10 @@ void nano::json_handler::unchecked_get ()
 	if (!ec)
 	{
 		auto transaction (node.store.tx_begin_read ());
-		for (auto i (node.store.unchecked_begin (transaction)), n (node.store.unchecked_end ()); i != n; ++i)
-		{
-			nano::unchecked_key const & key (i->first);
-			if (key.hash == hash)
+		node.unchecked.for_each (transaction, [this, &hash, json_block_l](nano::unchecked_key const & key, nano::unchecked_info const & info) {
+			auto found (key.hash == hash);
+			if (found)
 			{
-				nano::unchecked_info const & info (i->second);
 				response_l.put ("modified_timestamp", std::to_string (info.modified));
 
 				if (json_block_l)
@@ -4087,9 +4120,9 @@ void nano::json_handler::unchecked_get ()
 					info.block->serialize_json (contents);
 					response_l.put ("contents", contents);
 				}
-				break;
 			}
-		}
+			return !found;
+		});
 		if (response_l.empty ())
 		{
 			ec = nano::error_blocks::not_found;
@@ -4115,11 +4148,9 @@ void nano::json_handler::unchecked_keys ()
 	{
 		boost::property_tree::ptree unchecked;
 		auto transaction (node.store.tx_begin_read ());
-		for (auto i (node.store.unchecked_begin (transaction, nano::unchecked_key (key, 0))), n (node.store.unchecked_end ()); i != n && unchecked.size () < count; ++i)
-		{
+		node.unchecked.for_each (transaction, [&unchecked, count, json_block_l](nano::unchecked_key const & key_a, nano::unchecked_info const & info) {
 			boost::property_tree::ptree entry;
-			nano::unchecked_info const & info (i->second);
-			entry.put ("key", i->first.key ().to_string ());
+			entry.put ("key", key_a.key ().to_string ());
 			entry.put ("hash", info.block->hash ().to_string ());
 			entry.put ("modified_timestamp", std::to_string (info.modified));
 			if (json_block_l)
@@ -4135,7 +4166,9 @@ void nano::json_handler::unchecked_keys ()
 				entry.put ("contents", contents);
 			}
 			unchecked.push_back (std::make_pair ("", entry));
-		}
+			return unchecked.size () < count;
+		},
+		nano::unchecked_key (key, 0));
 		response_l.add_child ("unchecked", unchecked);
 	}
 	response_errors ();
@@ -4596,9 +4629,10 @@ void nano::json_handler::wallet_ledger ()
 		modified_since = strtoul (modified_since_text.get ().c_str (), NULL, 10);
 	}
 	auto wallet (wallet_impl ());
+	nano::json_writer writer;
 	if (!ec)
 	{
-		boost::property_tree::ptree accounts;
+		writer.begin_object ("accounts");
 		auto transaction (node.wallets.tx_begin_read ());
 		auto block_transaction (node.store.tx_begin_read ());
 		for (auto i (wallet->store.begin (transaction)), n (wallet->store.end ()); i != n; ++i)
@@ -4609,36 +4643,36 @@ void nano::json_handler::wallet_ledger ()
 			{
 				if (info.modified >= modified_since)
 				{
-					boost::property_tree::ptree entry;
-					entry.put ("frontier", info.head.to_string ());
-					entry.put ("open_block", info.open_block.to_string ());
-					entry.put ("representative_block", node.ledger.representative (block_transaction, info.head).to_string ());
+					writer.begin_object (account.to_account ());
+					writer.put ("frontier", info.head.to_string ());
+					writer.put ("open_block", info.open_block.to_string ());
+					writer.put ("representative_block", node.ledger.representative (block_transaction, info.head).to_string ());
 					std::string balance;
 					nano::uint128_union (info.balance).encode_dec (balance);
-					entry.put ("balance", balance);
-					entry.put ("modified_timestamp", std::to_string (info.modified));
-					entry.put ("block_count", std::to_string (info.block_count));
+					writer.put ("balance", balance);
+					writer.put ("modified_timestamp", std::to_string (info.modified));
+					writer.put ("block_count", std::to_string (info.block_count));
 					if (representative)
 					{
-						entry.put ("representative", info.representative.to_account ());
+						writer.put ("representative", info.representative.to_account ());
 					}
 					if (weight)
 					{
 						auto account_weight (node.ledger.weight (account));
-						entry.put ("weight", account_weight.convert_to<std::string> ());
+						writer.put ("weight", account_weight.convert_to<std::string> ());
 					}
 					if (pending)
 					{
 						auto account_pending (node.ledger.account_pending (block_transaction, account));
-						entry.put ("pending", account_pending.convert_to<std::string> ());
+						writer.put ("pending", account_pending.convert_to<std::string> ());
 					}
-					accounts.push_back (std::make_pair (account.to_account (), entry));
+					writer.end ();
 				}
 			}
 		}
-		response_l.add_child ("accounts", accounts);
+		writer.end ();
 	}
-	response_errors ();
+	response_json (writer);
 }
 
 void nano::json_handler::wallet_lock ()
@@ -11,6 +11,7 @@
 
 namespace nano
 {
+class json_writer;
 class node;
 class node_rpc_config;
 
@@ -139,6 +140,7 @@ public:
 	boost::property_tree::ptree request;
 	std::function<void(std::string const &)> response;
 	void response_errors ();
+	void response_json (nano::json_writer &);
 	std::error_code ec;
 	std::string action;
 	boost::property_tree::ptree response_l;
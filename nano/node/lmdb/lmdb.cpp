@@ -40,7 +40,8 @@ void mdb_val::convert_buffer_to_value ()
 }
 }
 
-nano::mdb_store::mdb_store (nano::logger_mt & logger_a, boost::filesystem::path const & path_a, nano::txn_tracking_config const & txn_tracking_config_a, std::chrono::milliseconds block_processor_batch_max_time_a, int lmdb_max_dbs, size_t const batch_size, bool backup_before_upgrade) :
+nano::mdb_store::mdb_store (nano::logger_mt & logger_a, boost::filesystem::path const & path_a, nano::txn_tracking_config const & txn_tracking_config_a, std::chrono::milliseconds block_processor_batch_max_time_a, int lmdb_max_dbs, size_t const batch_size, bool backup_before_upgrade, nano::stat * stats_a) :
+block_store_partial (stats_a),
 logger (logger_a),
 env (error, path_a, lmdb_max_dbs, true),
 mdb_txn_tracker (logger_a, txn_tracking_config_a, block_processor_batch_max_time_a),
@@ -51,7 +52,8 @@ txn_tracking_enabled (txn_tracking_config_a.enable)
 		auto is_fully_upgraded (false);
 		auto is_fresh_db (false);
 		{
-			auto transaction (tx_begin_read ());
+			// Databases are opened in unpooled transactions, pooled ones are reset which discards any DBI handles opened in them
+			auto transaction (env.tx_begin_read (create_txn_callbacks ()));
 			auto err = mdb_dbi_open (env.tx (transaction), "meta", 0, &meta);
 			is_fresh_db = err != MDB_SUCCESS;
 			if (err == MDB_SUCCESS)
@@ -97,7 +99,7 @@ txn_tracking_enabled (txn_tracking_config_a.enable)
 		}
 		else
 		{
-			auto transaction (tx_begin_read ());
+			auto transaction (env.tx_begin_read (create_txn_callbacks ()));
 			open_databases (error, transaction, 0);
 		}
 	}
@@ -112,6 +114,7 @@ bool nano::mdb_store::vacuum_after_upgrade (boost::filesystem::path const & path
 	if (vacuum_success)
 	{
 		// Need to close the database to release the file handle
+		env.read_txn_pool_clear ();
 		mdb_env_close (env.environment);
 		env.environment = nullptr;
 
@@ -122,7 +125,7 @@ bool nano::mdb_store::vacuum_after_upgrade (boost::filesystem::path const & path
 		env.init (error, path_a, lmdb_max_dbs, true);
 		if (!error)
 		{
-			auto transaction (tx_begin_read ());
+			auto transaction (env.tx_begin_read (create_txn_callbacks ()));
 			open_databases (error, transaction, 0);
 		}
 	}
@@ -146,7 +149,7 @@ nano::write_transaction nano::mdb_store::tx_begin_write (std::vector<nano::table
 
 nano::read_transaction nano::mdb_store::tx_begin_read ()
 {
-	return env.tx_begin_read (create_txn_callbacks ());
+	return env.tx_begin_read_pooled (create_txn_callbacks ());
 }
 
 std::string nano::mdb_store::vendor_get () const
@@ -260,6 +263,8 @@ bool nano::mdb_store::do_upgrades (nano::write_transaction & transaction_a, bool
 			error = true;
 			break;
 	}
+	// Upgrades rewrite block entries directly, drop anything read in an older format
+	block_cache.clear ();
 	return error;
 }
 
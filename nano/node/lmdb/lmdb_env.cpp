@@ -1,3 +1,4 @@
+#include <nano/lib/locks.hpp>
 #include <nano/node/lmdb/lmdb_env.hpp>
 
 #include <boost/filesystem/operations.hpp>
@@ -69,6 +70,7 @@ nano::mdb_env::~mdb_env ()
 {
 	if (environment != nullptr)
 	{
+		read_txn_pool_clear ();
 		mdb_env_close (environment);
 	}
 }
@@ -83,6 +85,11 @@ nano::read_transaction nano::mdb_env::tx_begin_read (mdb_txn_callbacks mdb_txn_c
 	return nano::read_transaction{ std::make_unique<nano::read_mdb_txn> (*this, mdb_txn_callbacks) };
 }
 
+nano::read_transaction nano::mdb_env::tx_begin_read_pooled (mdb_txn_callbacks mdb_txn_callbacks) const
+{
+	return nano::read_transaction{ std::make_unique<nano::read_mdb_txn> (*this, mdb_txn_callbacks, true) };
+}
+
 nano::write_transaction nano::mdb_env::tx_begin_write (mdb_txn_callbacks mdb_txn_callbacks) const
 {
 	return nano::write_transaction{ std::make_unique<nano::write_mdb_txn> (*this, mdb_txn_callbacks) };
@@ -92,3 +99,55 @@ MDB_txn * nano::mdb_env::tx (nano::transaction const & transaction_a) const
 {
 	return static_cast<MDB_txn *> (transaction_a.get_handle ());
 }
+
+MDB_txn * nano::mdb_env::read_txn_acquire () const
+{
+	MDB_txn * result (nullptr);
+	{
+		nano::lock_guard<std::mutex> lock (read_txn_pool_mutex);
+		if (!read_txn_pool.empty ())
+		{
+			result = read_txn_pool.back ();
+			read_txn_pool.pop_back ();
+		}
+	}
+	if (result != nullptr)
+	{
+		auto status (mdb_txn_renew (result));
+		release_assert (status == MDB_SUCCESS);
+	}
+	else
+	{
+		auto status (mdb_txn_begin (environment, nullptr, MDB_RDONLY, &result));
+		release_assert (status == MDB_SUCCESS);
+	}
+	return result;
+}
+
+void nano::mdb_env::read_txn_release (MDB_txn * txn_a) const
+{
+	// Resetting an already reset transaction is a no-op
+	mdb_txn_reset (txn_a);
+	{
+		nano::lock_guard<std::mutex> lock (read_txn_pool_mutex);
+		if (read_txn_pool.size () < read_txn_pool_max)
+		{
+			read_txn_pool.push_back (txn_a);
+			txn_a = nullptr;
+		}
+	}
+	if (txn_a != nullptr)
+	{
+		mdb_txn_abort (txn_a);
+	}
+}
+
+void nano::mdb_env::read_txn_pool_clear ()
+{
+	nano::lock_guard<std::mutex> lock (read_txn_pool_mutex);
+	for (auto txn : read_txn_pool)
+	{
+		mdb_txn_abort (txn);
+	}
+	read_txn_pool.clear ();
+}
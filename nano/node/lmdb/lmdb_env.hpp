@@ -3,6 +3,9 @@
 #include <nano/node/lmdb/lmdb_txn.hpp>
 #include <nano/secure/blockstore.hpp>
 
+#include <mutex>
+#include <vector>
+
 namespace nano
 {
 /**
@@ -16,8 +19,23 @@ public:
 	~mdb_env ();
 	operator MDB_env * () const;
 	nano::read_transaction tx_begin_read (mdb_txn_callbacks txn_callbacks = mdb_txn_callbacks{}) const;
+	/**
+	 * Reuses a reset read transaction from the pool when one is available, avoiding mdb_txn_begin/commit.
+	 * DBI handles must not be opened in these transactions as they are discarded when the transaction is reset.
+	 */
+	nano::read_transaction tx_begin_read_pooled (mdb_txn_callbacks txn_callbacks = mdb_txn_callbacks{}) const;
 	nano::write_transaction tx_begin_write (mdb_txn_callbacks txn_callbacks = mdb_txn_callbacks{}) const;
 	MDB_txn * tx (nano::transaction const & transaction_a) const;
+	MDB_txn * read_txn_acquire () const;
+	void read_txn_release (MDB_txn *) const;
+	/** Aborts every pooled transaction, must be called before the environment is closed */
+	void read_txn_pool_clear ();
 	MDB_env * environment;
+	/** Each pooled transaction keeps its reader slot, so this stays well below the default of 126 readers */
+	static size_t constexpr read_txn_pool_max{ 32 };
+
+private:
+	mutable std::mutex read_txn_pool_mutex;
+	mutable std::vector<MDB_txn *> read_txn_pool;
 };
 }
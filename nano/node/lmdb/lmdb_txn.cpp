@@ -49,19 +49,35 @@ private:
 };
 }
 
-nano::read_mdb_txn::read_mdb_txn (nano::mdb_env const & environment_a, nano::mdb_txn_callbacks txn_callbacks_a) :
-txn_callbacks (txn_callbacks_a)
+nano::read_mdb_txn::read_mdb_txn (nano::mdb_env const & environment_a, nano::mdb_txn_callbacks txn_callbacks_a, bool pooled_a) :
+env (environment_a),
+txn_callbacks (txn_callbacks_a),
+pooled (pooled_a)
 {
-	auto status (mdb_txn_begin (environment_a, nullptr, MDB_RDONLY, &handle));
-	release_assert (status == 0);
+	if (pooled)
+	{
+		handle = env.read_txn_acquire ();
+	}
+	else
+	{
+		auto status (mdb_txn_begin (env, nullptr, MDB_RDONLY, &handle));
+		release_assert (status == 0);
+	}
 	txn_callbacks.txn_start (this);
 }
 
 nano::read_mdb_txn::~read_mdb_txn ()
 {
-	// This uses commit rather than abort, as it is needed when opening databases with a read only transaction
-	auto status (mdb_txn_commit (handle));
-	release_assert (status == MDB_SUCCESS);
+	if (pooled)
+	{
+		env.read_txn_release (handle);
+	}
+	else
+	{
+		// This uses commit rather than abort, as it is needed when opening databases with a read only transaction
+		auto status (mdb_txn_commit (handle));
+		release_assert (status == MDB_SUCCESS);
+	}
 	txn_callbacks.txn_end (this);
 }
 
@@ -27,13 +27,16 @@ public:
 class read_mdb_txn final : public read_transaction_impl
 {
 public:
-	read_mdb_txn (nano::mdb_env const &, mdb_txn_callbacks mdb_txn_callbacks);
+	read_mdb_txn (nano::mdb_env const &, mdb_txn_callbacks mdb_txn_callbacks, bool pooled = false);
 	~read_mdb_txn ();
 	void reset () override;
 	void renew () override;
 	void * get_handle () const override;
 	MDB_txn * handle;
+	nano::mdb_env const & env;
 	mdb_txn_callbacks txn_callbacks;
+	/** Returned to the environment's pool on destruction rather than committed */
+	bool const pooled;
 };
 
 class write_mdb_txn final : public write_transaction_impl
@@ -14,6 +14,7 @@ nano::network::network (nano::node & node_a, uint16_t port_a) :
 buffer_container (node_a.stats, nano::network::buffer_size, 4096), // 2Mb receive buffer
 resolver (node_a.io_ctx),
 limiter (node_a.config.bandwidth_limit),
+publish_filter (publish_filter_size),
 node (node_a),
 udp_channels (node_a, port_a),
 tcp_channels (node_a),
@@ -215,10 +216,36 @@ bool nano::network::send_votes_cache (std::shared_ptr<nano::transport::channel>
 
 void nano::network::flood_message (nano::message const & message_a, bool const is_droppable_a)
 {
-	auto list (list_fanout ());
-	for (auto i (list.begin ()), n (list.end ()); i != n; ++i)
+	broadcast (list_fanout (), message_a, is_droppable_a);
+}
+
+void nano::network::broadcast (std::deque<std::shared_ptr<nano::transport::channel>> const & channels_a, nano::message const & message_a, bool const is_droppable_a)
+{
+	if (!channels_a.empty ())
 	{
-		(*i)->send (message_a, nullptr, is_droppable_a);
+		auto buffer (message_a.to_shared_const_buffer ());
+		auto detail (nano::transport::message_detail (message_a));
+		// The broadcast is sent or dropped as a whole. As in channel::send, adding first rolls the trend over if a limiter period has passed
+		auto size (buffer.size () * channels_a.size ());
+		limiter.add (size, !is_droppable_a);
+		auto drop (is_droppable_a && limiter.should_drop (size));
+		if (!drop)
+		{
+			for (auto const & channel : channels_a)
+			{
+				channel->send_buffer (buffer, detail);
+			}
+			node.stats.add (nano::stat::type::message, detail, nano::stat::dir::out, channels_a.size ());
+		}
+		else
+		{
+			node.stats.add (nano::stat::type::drop, detail, nano::stat::dir::out, channels_a.size ());
+			if (node.config.logging.network_packet_logging ())
+			{
+				auto key = static_cast<uint8_t> (detail) << 8;
+				node.logger.always_log (boost::str (boost::format ("%1% of size %2% dropped for %3% channels") % node.stats.detail_to_string (key) % buffer.size () % channels_a.size ()));
+			}
+		}
 	}
 }
 
@@ -415,12 +442,18 @@ public:
 			node.logger.try_log (boost::str (boost::format ("Publish message from %1% for %2%") % channel->to_string () % message_a.block->hash ().to_string ()));
 		}
 		node.stats.inc (nano::stat::type::message, nano::stat::detail::publish, nano::stat::dir::in);
+		if (message_a.digest != 0)
+		{
+			node.stats.inc (nano::stat::type::filter, nano::stat::detail::unique_publish, nano::stat::dir::in);
+		}
 		if (!node.block_processor.full ())
 		{
 			node.process_active (message_a.block);
 		}
 		else
 		{
+			// Allow the block to be received again once there is room for it
+			node.network.publish_filter.clear (message_a.digest);
 			node.stats.inc (nano::stat::type::drop, nano::stat::detail::publish, nano::stat::dir::in);
 		}
 		node.active.publish (message_a.block);
@@ -99,6 +99,8 @@ public:
 	void start ();
 	void stop ();
 	void flood_message (nano::message const &, bool const = true);
+	/** Serializes the message once and sends the shared buffer to every channel, the bandwidth limiter decides for the whole broadcast */
+	void broadcast (std::deque<std::shared_ptr<nano::transport::channel>> const &, nano::message const &, bool const = true);
 	void flood_keepalive ()
 	{
 		nano::keepalive message;
@@ -156,6 +158,8 @@ public:
 	boost::asio::ip::udp::resolver resolver;
 	std::vector<boost::thread> packet_processing_threads;
 	nano::bandwidth_limiter limiter;
+	// Recently received publish payloads, used to drop republished blocks before they are deserialized
+	nano::network_filter publish_filter;
 	nano::node & node;
 	nano::transport::udp_channels udp_channels;
 	nano::transport::tcp_channels tcp_channels;
@@ -168,6 +172,7 @@ public:
 	static size_t const buffer_size = 512;
 	static size_t const confirm_req_hashes_max = 7;
 	static size_t const confirm_ack_hashes_max = 12;
+	static size_t const publish_filter_size = 256 * 1024;
 };
 std::unique_ptr<container_info_component> collect_container_info (network & network, const std::string & name);
 }
@@ -32,6 +32,15 @@ extern unsigned char nano_bootstrap_weights_beta[];
 extern size_t nano_bootstrap_weights_beta_size;
 }
 
+namespace
+{
+/** Only nodes which can write to the ledger take and consume cache snapshots, an empty path disables them */
+boost::filesystem::path ledger_cache_snapshot_path (boost::filesystem::path const & application_path_a, nano::node_flags const & flags_a)
+{
+	return (flags_a.read_only || flags_a.disable_ledger_cache_snapshot) ? boost::filesystem::path () : application_path_a / "ledger_cache.snapshot";
+}
+}
+
 void nano::node::keepalive (std::string const & address_a, uint16_t port_a)
 {
 	auto node_l (shared_from_this ());
@@ -96,7 +105,7 @@ std::unique_ptr<nano::container_info_component> nano::collect_container_info (bl
 
 	auto composite = std::make_unique<container_info_composite> (name);
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "state_blocks", state_blocks_count, sizeof (decltype (block_processor.state_blocks)::value_type) }));
-	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "blocks", blocks_count, sizeof (decltype (block_processor.blocks)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "blocks", blocks_count, sizeof (nano::unchecked_info) }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "blocks_filter", blocks_filter_count, sizeof (decltype (block_processor.blocks_filter)::value_type) }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "forced", forced_count, sizeof (decltype (block_processor.forced)::value_type) }));
 	composite->add_component (collect_container_info (block_processor.generator, "generator"));
@@ -118,13 +127,14 @@ alarm (alarm_a),
 work (work_a),
 distributed_work (*this),
 logger (config_a.logging.min_time_between_log_output),
-store_impl (nano::make_store (logger, application_path_a, flags.read_only, true, config_a.rocksdb_config, config_a.diagnostics_config.txn_tracking, config_a.block_processor_batch_max_time, config_a.lmdb_max_dbs, flags.sideband_batch_size, config_a.backup_before_upgrade, config_a.rocksdb_config.enable)),
+store_impl (nano::make_store (logger, application_path_a, flags.read_only, true, config_a.rocksdb_config, config_a.diagnostics_config.txn_tracking, config_a.block_processor_batch_max_time, config_a.lmdb_max_dbs, flags.sideband_batch_size, config_a.backup_before_upgrade, config_a.rocksdb_config.enable, &stats)),
 store (*store_impl),
 wallets_store_impl (std::make_unique<nano::mdb_wallets_store> (application_path_a / "wallets.ldb", config_a.lmdb_max_dbs)),
 wallets_store (*wallets_store_impl),
 gap_cache (*this),
-ledger (store, stats, flags_a.generate_cache),
-checker (config.signature_checker_threads),
+unchecked (store, flags.unchecked_cache_size),
+ledger (store, stats, flags_a.generate_cache, ledger_cache_snapshot_path (application_path_a, flags_a)),
+checker (config.signature_checker_threads, flags.signature_checker_batch_size),
 network (*this, config.peering_port),
 telemetry (network, alarm, worker),
 bootstrap_initiator (*this),
@@ -156,7 +166,7 @@ startup_time (std::chrono::steady_clock::now ())
 		if (config.websocket_config.enabled)
 		{
 			auto endpoint_l (nano::tcp_endpoint (boost::asio::ip::make_address_v6 (config.websocket_config.address), config.websocket_config.port));
-			websocket_server = std::make_shared<nano::websocket::listener> (logger, wallets, io_ctx, endpoint_l);
+			websocket_server = std::make_shared<nano::websocket::listener> (config.websocket_config, logger, wallets, stats, io_ctx, endpoint_l);
 			this->websocket_server->run ();
 		}
 
@@ -327,6 +337,10 @@ startup_time (std::chrono::steady_clock::now ())
 					this->websocket_server->broadcast (msg);
 				}
 			});
+			// Replays are only filtered before signature checking while nobody subscribes to votes
+			vote_processor.replay_observed = [this]() {
+				return this->websocket_server->any_subscriber (nano::websocket::topic::vote);
+			};
 		}
 		// Cancelling local work generation
 		observers.work_cancel.add ([this](nano::root const & root_a) {
@@ -441,7 +455,7 @@ startup_time (std::chrono::steady_clock::now ())
 			if (!flags.disable_unchecked_drop && !use_bootstrap_weight && !flags.read_only)
 			{
 				auto transaction (store.tx_begin_write ());
-				store.unchecked_clear (transaction);
+				unchecked.clear (transaction);
 				ledger.cache.unchecked_count = 0;
 				logger.always_log ("Dropping unchecked blocks");
 			}
@@ -578,6 +592,7 @@ std::unique_ptr<nano::container_info_component> nano::collect_container_info (no
 	composite->add_component (collect_container_info (node.alarm, "alarm"));
 	composite->add_component (collect_container_info (node.work, "work"));
 	composite->add_component (collect_container_info (node.gap_cache, "gap_cache"));
+	composite->add_component (collect_container_info (node.unchecked, "unchecked"));
 	composite->add_component (collect_container_info (node.ledger, "ledger"));
 	composite->add_component (collect_container_info (node.active, "active"));
 	composite->add_component (collect_container_info (node.bootstrap_initiator, "bootstrap_initiator"));
@@ -709,6 +724,22 @@ void nano::node::stop ()
 		wallets.stop ();
 		stats.stop ();
 		worker.stop ();
+		// Persist unchecked blocks still held in memory
+		if (!store.init_error () && !flags.read_only)
+		{
+			auto transaction (store.tx_begin_write ({ tables::unchecked }));
+			unchecked.flush (transaction);
+		}
+		// Ledger writers have all stopped, save the cache so the next startup does not need to scan the ledger
+		auto snapshot_path (ledger_cache_snapshot_path (application_path, flags));
+		auto const & generate_cache (flags.generate_cache);
+		if (!store.init_error () && !snapshot_path.empty () && generate_cache.reps && generate_cache.cemented_count && generate_cache.unchecked_count)
+		{
+			if (ledger.cache_snapshot_write (snapshot_path))
+			{
+				logger.always_log ("Error writing ledger cache snapshot");
+			}
+		}
 		// work pool is not stopped on purpose due to testing setup
 	}
 }
@@ -930,15 +961,13 @@ void nano::node::unchecked_cleanup ()
 		auto now (nano::seconds_since_epoch ());
 		auto transaction (store.tx_begin_read ());
 		// Max 1M records to clean, max 2 minutes reading to prevent slow i/o systems issues
-		for (auto i (store.unchecked_begin (transaction)), n (store.unchecked_end ()); i != n && cleaning_list.size () < 1024 * 1024 && nano::seconds_since_epoch () - now < 120; ++i)
-		{
-			nano::unchecked_key const & key (i->first);
-			nano::unchecked_info const & info (i->second);
+		unchecked.for_each (transaction, [this, &cleaning_list, now](nano::unchecked_key const & key, nano::unchecked_info const & info) {
 			if ((now - info.modified) > static_cast<uint64_t> (config.unchecked_cutoff_time.count ()))
 			{
 				cleaning_list.push_back (key);
 			}
-		}
+			return cleaning_list.size () < 1024 * 1024 && nano::seconds_since_epoch () - now < 120;
+		});
 	}
 	if (!cleaning_list.empty ())
 	{
@@ -953,7 +982,7 @@ void nano::node::unchecked_cleanup ()
 		{
 			auto key (cleaning_list.front ());
 			cleaning_list.pop_front ();
-			if (!store.unchecked_del (transaction, key))
+			if (!unchecked.del (transaction, key))
 			{
 				assert (ledger.cache.unchecked_count > 0);
 				--ledger.cache.unchecked_count;
@@ -1393,11 +1422,11 @@ nano::node_flags const & nano::inactive_node_flag_defaults ()
 	return node_flags;
 }
 
-std::unique_ptr<nano::block_store> nano::make_store (nano::logger_mt & logger, boost::filesystem::path const & path, bool read_only, bool add_db_postfix, nano::rocksdb_config const & rocksdb_config, nano::txn_tracking_config const & txn_tracking_config_a, std::chrono::milliseconds block_processor_batch_max_time_a, int lmdb_max_dbs, size_t batch_size, bool backup_before_upgrade, bool use_rocksdb_backend)
+std::unique_ptr<nano::block_store> nano::make_store (nano::logger_mt & logger, boost::filesystem::path const & path, bool read_only, bool add_db_postfix, nano::rocksdb_config const & rocksdb_config, nano::txn_tracking_config const & txn_tracking_config_a, std::chrono::milliseconds block_processor_batch_max_time_a, int lmdb_max_dbs, size_t batch_size, bool backup_before_upgrade, bool use_rocksdb_backend, nano::stat * stats)
 {
 #if NANO_ROCKSDB
-	auto make_rocksdb = [&logger, add_db_postfix, &path, &rocksdb_config, read_only]() {
-		return std::make_unique<nano::rocksdb_store> (logger, add_db_postfix ? path / "rocksdb" : path, rocksdb_config, read_only);
+	auto make_rocksdb = [&logger, add_db_postfix, &path, &rocksdb_config, read_only, stats]() {
+		return std::make_unique<nano::rocksdb_store> (logger, add_db_postfix ? path / "rocksdb" : path, rocksdb_config, read_only, stats);
 	};
 #endif
 
@@ -1424,5 +1453,5 @@ std::unique_ptr<nano::block_store> nano::make_store (nano::logger_mt & logger, b
 #endif
 	}
 
-	return std::make_unique<nano::mdb_store> (logger, add_db_postfix ? path / "data.ldb" : path, txn_tracking_config_a, block_processor_batch_max_time_a, lmdb_max_dbs, batch_size, backup_before_upgrade);
+	return std::make_unique<nano::mdb_store> (logger, add_db_postfix ? path / "data.ldb" : path, txn_tracking_config_a, block_processor_batch_max_time_a, lmdb_max_dbs, batch_size, backup_before_upgrade, stats);
 }
@@ -9,6 +9,7 @@
 #include <nano/lib/stats.hpp>
 #include <nano/node/ipcconfig.hpp>
 #include <nano/node/logging.hpp>
+#include <nano/node/signatures.hpp>
 #include <nano/node/websocketconfig.hpp>
 #include <nano/secure/common.hpp>
 
@@ -124,6 +125,7 @@ public:
 	bool disable_udp{ false };
 	bool disable_unchecked_cleanup{ false };
 	bool disable_unchecked_drop{ true };
+	bool disable_ledger_cache_snapshot{ false };
 	bool fast_bootstrap{ false };
 	bool read_only{ false };
 	nano::generate_cache generate_cache;
@@ -132,5 +134,7 @@ public:
 	size_t block_processor_batch_size{ 0 };
 	size_t block_processor_full_size{ 65536 };
 	size_t block_processor_verification_size{ 0 };
+	size_t signature_checker_batch_size{ nano::signature_checker::default_batch_size };
+	size_t unchecked_cache_size{ 64 * 1024 };
 };
 }
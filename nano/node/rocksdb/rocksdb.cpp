@@ -14,6 +14,8 @@
 #include <rocksdb/utilities/transaction.h>
 #include <rocksdb/utilities/transaction_db.h>
 
+#include <unordered_set>
+
 namespace nano
 {
 template <>
@@ -41,7 +43,18 @@ void rocksdb_val::convert_buffer_to_value ()
 }
 }
 
-nano::rocksdb_store::rocksdb_store (nano::logger_mt & logger_a, boost::filesystem::path const & path_a, nano::rocksdb_config const & rocksdb_config_a, bool open_read_only_a) :
+namespace
+{
+bool is_point_lookup_table (std::string const & cf_name_a)
+{
+	// Small tables which are mostly iterated do not benefit from a bloom filter
+	static std::unordered_set<std::string> const small_tables{ rocksdb::kDefaultColumnFamilyName, "vote", "online_weight", "meta", "peers", "cached_counts" };
+	return small_tables.find (cf_name_a) == small_tables.end ();
+}
+}
+
+nano::rocksdb_store::rocksdb_store (nano::logger_mt & logger_a, boost::filesystem::path const & path_a, nano::rocksdb_config const & rocksdb_config_a, bool open_read_only_a, nano::stat * stats_a) :
+block_store_partial (stats_a),
 logger (logger_a),
 rocksdb_config (rocksdb_config_a)
 {
@@ -52,8 +65,13 @@ rocksdb_config (rocksdb_config_a)
 
 	if (!error)
 	{
-		auto table_options = get_table_options ();
-		table_factory.reset (rocksdb::NewBlockBasedTableFactory (table_options));
+		auto block_cache_l (rocksdb::NewLRUCache (rocksdb_config.block_cache * 1024 * 1024ULL));
+		table_factory.reset (rocksdb::NewBlockBasedTableFactory (get_table_options (block_cache_l, true)));
+		if (rocksdb_config.table_profiles)
+		{
+			small_table_factory.reset (rocksdb::NewBlockBasedTableFactory (get_table_options (block_cache_l, false)));
+			unchecked_table_factory.reset (rocksdb::NewBlockBasedTableFactory (get_table_options (rocksdb::NewLRUCache (rocksdb_config.unchecked_block_cache * 1024 * 1024ULL), true)));
+		}
 		if (!open_read_only_a)
 		{
 			construct_column_family_mutexes ();
@@ -78,7 +96,7 @@ void nano::rocksdb_store::open (bool & error_a, boost::filesystem::path const &
 	std::vector<rocksdb::ColumnFamilyDescriptor> column_families;
 	for (const auto & cf_name : names)
 	{
-		column_families.emplace_back (cf_name, get_cf_options ());
+		column_families.emplace_back (cf_name, get_cf_options (cf_name));
 	}
 
 	auto options = get_db_options ();
@@ -441,7 +459,7 @@ int nano::rocksdb_store::clear (rocksdb::ColumnFamilyHandle * column_family)
 	// Need to add it back as we just want to clear the contents
 	auto handle_it = std::find (handles.begin (), handles.end (), column_family);
 	assert (handle_it != handles.cend ());
-	status = db->CreateColumnFamily (get_cf_options (), name, &column_family);
+	status = db->CreateColumnFamily (get_cf_options (name), name, &column_family);
 	release_assert (status.ok ());
 	*handle_it = column_family;
 	return status.code ();
@@ -480,16 +498,16 @@ rocksdb::Options nano::rocksdb_store::get_db_options () const
 	return db_options;
 }
 
-rocksdb::BlockBasedTableOptions nano::rocksdb_store::get_table_options () const
+rocksdb::BlockBasedTableOptions nano::rocksdb_store::get_table_options (std::shared_ptr<rocksdb::Cache> const & block_cache_a, bool bloom_filter_a) const
 {
 	rocksdb::BlockBasedTableOptions table_options;
 
 	// Block cache for reads
-	table_options.block_cache = rocksdb::NewLRUCache (rocksdb_config.block_cache * 1024 * 1024ULL);
+	table_options.block_cache = block_cache_a;
 
 	// Bloom filter to help with point reads
 	auto bloom_filter_bits = rocksdb_config.bloom_filter_bits;
-	if (bloom_filter_bits > 0)
+	if (bloom_filter_a && bloom_filter_bits > 0)
 	{
 		table_options.filter_policy.reset (rocksdb::NewBloomFilterPolicy (bloom_filter_bits, false));
 	}
@@ -504,7 +522,7 @@ rocksdb::BlockBasedTableOptions nano::rocksdb_store::get_table_options () const
 	return table_options;
 }
 
-rocksdb::ColumnFamilyOptions nano::rocksdb_store::get_cf_options () const
+rocksdb::ColumnFamilyOptions nano::rocksdb_store::get_cf_options (std::string const & cf_name_a) const
 {
 	rocksdb::ColumnFamilyOptions cf_options;
 	cf_options.table_factory = table_factory;
@@ -533,6 +551,26 @@ rocksdb::ColumnFamilyOptions nano::rocksdb_store::get_cf_options () const
 	// Number of memtables to keep in memory (1 active, rest inactive/immutable)
 	cf_options.max_write_buffer_number = rocksdb_config.num_memtables;
 
+	if (rocksdb_config.table_profiles)
+	{
+		if (cf_name_a == "pending" || cf_name_a == "unchecked")
+		{
+			// Keys start with the account (pending) or dependency hash (unchecked) they are searched by, so filter on that prefix
+			cf_options.prefix_extractor.reset (rocksdb::NewFixedPrefixTransform (sizeof (nano::account)));
+			cf_options.memtable_prefix_bloom_size_ratio = 0.02;
+		}
+		if (cf_name_a == "unchecked")
+		{
+			// Entries are short lived and have a separate cache so they cannot evict ledger blocks. Compact old files sooner to discard deleted entries
+			cf_options.table_factory = unchecked_table_factory;
+			cf_options.ttl = rocksdb_config.unchecked_ttl;
+		}
+		else if (!is_point_lookup_table (cf_name_a))
+		{
+			cf_options.table_factory = small_table_factory;
+		}
+	}
+
 	return cf_options;
 }
 
@@ -11,6 +11,7 @@
 #include <rocksdb/filter_policy.h>
 #include <rocksdb/options.h>
 #include <rocksdb/slice.h>
+#include <rocksdb/slice_transform.h>
 #include <rocksdb/table.h>
 #include <rocksdb/utilities/optimistic_transaction_db.h>
 #include <rocksdb/utilities/transaction.h>
@@ -26,7 +27,7 @@ class rocksdb_config;
 class rocksdb_store : public block_store_partial<rocksdb::Slice, rocksdb_store>
 {
 public:
-	rocksdb_store (nano::logger_mt &, boost::filesystem::path const &, nano::rocksdb_config const & = nano::rocksdb_config{}, bool open_read_only = false);
+	rocksdb_store (nano::logger_mt &, boost::filesystem::path const &, nano::rocksdb_config const & = nano::rocksdb_config{}, bool open_read_only = false, nano::stat * = nullptr);
 	~rocksdb_store ();
 	nano::write_transaction tx_begin_write (std::vector<nano::tables> const & tables_requiring_lock = {}, std::vector<nano::tables> const & tables_no_lock = {}) override;
 	nano::read_transaction tx_begin_read () override;
@@ -79,6 +80,9 @@ private:
 	rocksdb::OptimisticTransactionDB * optimistic_db = nullptr;
 	rocksdb::DB * db = nullptr;
 	std::shared_ptr<rocksdb::TableFactory> table_factory;
+	// Only used when rocksdb_config.table_profiles is enabled
+	std::shared_ptr<rocksdb::TableFactory> small_table_factory;
+	std::shared_ptr<rocksdb::TableFactory> unchecked_table_factory;
 	std::unordered_map<nano::tables, std::mutex> write_lock_mutexes;
 
 	rocksdb::Transaction * tx (nano::transaction const & transaction_a) const;
@@ -98,10 +102,10 @@ private:
 
 	int increment (nano::write_transaction const & transaction_a, tables table_a, nano::rocksdb_val const & key_a, uint64_t amount_a);
 	int decrement (nano::write_transaction const & transaction_a, tables table_a, nano::rocksdb_val const & key_a, uint64_t amount_a);
-	rocksdb::ColumnFamilyOptions get_cf_options () const;
+	rocksdb::ColumnFamilyOptions get_cf_options (std::string const & cf_name_a) const;
 	void construct_column_family_mutexes ();
 	rocksdb::Options get_db_options () const;
-	rocksdb::BlockBasedTableOptions get_table_options () const;
+	rocksdb::BlockBasedTableOptions get_table_options (std::shared_ptr<rocksdb::Cache> const & block_cache_a, bool bloom_filter_a) const;
 	nano::rocksdb_config rocksdb_config;
 };
 
@@ -34,14 +34,18 @@ public:
 	rocksdb_iterator (rocksdb::DB * db, nano::transaction const & transaction_a, rocksdb::ColumnFamilyHandle * handle_a)
 	{
 		rocksdb::Iterator * iter;
+		// Iterating from the first entry walks across every prefix, so prefix mode must be bypassed here too
 		if (is_read (transaction_a))
 		{
-			iter = db->NewIterator (snapshot_options (transaction_a), handle_a);
+			auto options (snapshot_options (transaction_a));
+			options.total_order_seek = true;
+			iter = db->NewIterator (options, handle_a);
 		}
 		else
 		{
 			rocksdb::ReadOptions ropts;
 			ropts.fill_cache = false;
+			ropts.total_order_seek = true;
 			iter = tx (transaction_a)->GetIterator (ropts, handle_a);
 		}
 
@@ -64,13 +68,18 @@ public:
 	rocksdb_iterator (rocksdb::DB * db, nano::transaction const & transaction_a, rocksdb::ColumnFamilyHandle * handle_a, rocksdb_val const & val_a)
 	{
 		rocksdb::Iterator * iter;
+		// Iterators are commonly advanced past the prefix of the key they were positioned at, which prefix mode does not support
 		if (is_read (transaction_a))
 		{
-			iter = db->NewIterator (snapshot_options (transaction_a), handle_a);
+			auto options (snapshot_options (transaction_a));
+			options.total_order_seek = true;
+			iter = db->NewIterator (options, handle_a);
 		}
 		else
 		{
-			iter = tx (transaction_a)->GetIterator (rocksdb::ReadOptions (), handle_a);
+			rocksdb::ReadOptions options;
+			options.total_order_seek = true;
+			iter = tx (transaction_a)->GetIterator (options, handle_a);
 		}
 
 		cursor.reset (iter);
@@ -4,14 +4,18 @@
 #include <nano/lib/threading.hpp>
 #include <nano/node/signatures.hpp>
 
-nano::signature_checker::signature_checker (unsigned num_threads) :
+size_t constexpr nano::signature_checker::default_batch_size;
+
+nano::signature_checker::signature_checker (unsigned num_threads, size_t batch_size_a) :
 thread_pool (num_threads),
+batch_size (batch_size_a),
+multithreaded_cutoff (2 * batch_size_a + 1),
 single_threaded (num_threads == 0),
 num_threads (num_threads)
 {
 	if (!single_threaded)
 	{
-		set_thread_names (num_threads);
+		nano::thread_role::set (thread_pool, num_threads, nano::thread_role::name::signature_checking);
 	}
 }
 
@@ -125,46 +129,3 @@ void nano::signature_checker::verify_async (nano::signature_check_set & check_a,
 		});
 	}
 }
-
-// Set the names of all the threads in the thread pool for easier identification
-void nano::signature_checker::set_thread_names (unsigned num_threads)
-{
-	auto ready = false;
-	auto pending = num_threads;
-	nano::condition_variable cv;
-
-	std::vector<std::promise<void>> promises (num_threads);
-	std::vector<std::future<void>> futures;
-	futures.reserve (num_threads);
-	std::transform (promises.begin (), promises.end (), std::back_inserter (futures), [](auto & promise) {
-		return promise.get_future ();
-	});
-
-	for (auto i = 0u; i < num_threads; ++i)
-	{
-		boost::asio::post (thread_pool, [&cv, &ready, &pending, &mutex = mutex, &promise = promises[i]]() {
-			nano::unique_lock<std::mutex> lk (mutex);
-			nano::thread_role::set (nano::thread_role::name::signature_checking);
-			if (--pending == 0)
-			{
-				// All threads have been reached
-				ready = true;
-				lk.unlock ();
-				cv.notify_all ();
-			}
-			else
-			{
-				// We need to wait until the other threads are finished
-				cv.wait (lk, [&ready]() { return ready; });
-			}
-			promise.set_value ();
-		});
-	}
-
-	// Wait until all threads have finished
-	for (auto & future : futures)
-	{
-		future.wait ();
-	}
-	assert (pending == 0);
-}
@@ -29,11 +29,13 @@ public:
 class signature_checker final
 {
 public:
-	signature_checker (unsigned num_threads);
+	signature_checker (unsigned num_threads, size_t batch_size = default_batch_size);
 	~signature_checker ();
 	void verify (signature_check_set &);
 	void stop ();
 	void flush ();
+	/** Number of signatures handed to a thread pool worker as one task */
+	static size_t constexpr default_batch_size = 256;
 
 private:
 	struct Task final
@@ -52,12 +54,11 @@ private:
 
 	bool verify_batch (const nano::signature_check_set & check_a, size_t index, size_t size);
 	void verify_async (nano::signature_check_set & check_a, size_t num_batches, std::promise<void> & promise);
-	void set_thread_names (unsigned num_threads);
 	boost::asio::thread_pool thread_pool;
 	std::atomic<int> tasks_remaining{ 0 };
+	const size_t batch_size;
 	/** minimum signature_check_set size eligible to be multithreaded */
-	static constexpr size_t multithreaded_cutoff = 513;
-	static constexpr size_t batch_size = 256;
+	const size_t multithreaded_cutoff;
 	const bool single_threaded;
 	unsigned num_threads;
 	std::mutex mutex;
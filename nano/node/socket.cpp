@@ -1,11 +1,13 @@
 #include <nano/boost/asio/bind_executor.hpp>
 #include <nano/boost/asio/dispatch.hpp>
 #include <nano/boost/asio/read.hpp>
+#include <nano/boost/asio/write.hpp>
 #include <nano/node/node.hpp>
 #include <nano/node/socket.hpp>
 
 #include <boost/format.hpp>
 
+#include <algorithm>
 #include <limits>
 
 nano::socket::socket (std::shared_ptr<nano::node> node_a, boost::optional<std::chrono::seconds> io_timeout_a, nano::socket::concurrency concurrency_a) :
@@ -80,17 +82,16 @@ void nano::socket::async_write (nano::shared_const_buffer const & buffer_a, std:
 		if (writer_concurrency == nano::socket::concurrency::multi_writer)
 		{
 			boost::asio::post (strand, boost::asio::bind_executor (strand, [buffer_a, callback_a, this_l]() {
-				bool write_in_progress = !this_l->send_queue.empty ();
-				auto queue_size = this_l->send_queue.size ();
-				if (queue_size < this_l->queue_size_max)
+				if (this_l->queued_bytes == 0 || this_l->queued_bytes + buffer_a.size () <= this_l->queue_bytes_max)
 				{
 					this_l->send_queue.emplace_back (nano::socket::queue_item{ buffer_a, callback_a });
+					this_l->queued_bytes += buffer_a.size ();
 				}
 				else if (auto node_l = this_l->node.lock ())
 				{
 					node_l->stats.inc (nano::stat::type::tcp, nano::stat::detail::tcp_write_drop, nano::stat::dir::out);
 				}
-				if (!write_in_progress)
+				if (!this_l->writing && !this_l->send_queue.empty ())
 				{
 					this_l->write_queued_messages ();
 				}
@@ -121,11 +122,20 @@ void nano::socket::write_queued_messages ()
 	if (!closed)
 	{
 		std::weak_ptr<nano::socket> this_w (shared_from_this ());
-		auto msg (send_queue.front ());
+		// Queued messages are written together with a single vectored write, the batch keeps their buffers alive until completion
+		auto batch (std::make_shared<std::vector<queue_item>> ());
+		std::vector<boost::asio::const_buffer> buffers;
+		while (!send_queue.empty () && batch->size () < write_batch_max)
+		{
+			batch->push_back (std::move (send_queue.front ()));
+			send_queue.pop_front ();
+			buffers.insert (buffers.end (), batch->back ().buffer.begin (), batch->back ().buffer.end ());
+		}
+		writing = true;
 		start_timer ();
-		nano::async_write (tcp_socket, msg.buffer,
+		boost::asio::async_write (tcp_socket, buffers,
 		boost::asio::bind_executor (strand,
-		[msg, this_w](boost::system::error_code ec, std::size_t size_a) {
+		[batch, this_w](boost::system::error_code ec, std::size_t size_a) {
 			if (auto this_l = this_w.lock ())
 			{
 				if (auto node = this_l->node.lock ())
@@ -136,12 +146,19 @@ void nano::socket::write_queued_messages ()
 
 					if (!this_l->closed)
 					{
-						if (msg.callback)
+						// Attribute the written bytes to messages in order, a failed write may have completed some of them
+						auto remaining (size_a);
+						for (auto const & item : *batch)
 						{
-							msg.callback (ec, size_a);
+							auto written (std::min (remaining, item.buffer.size ()));
+							remaining -= written;
+							this_l->queued_bytes -= item.buffer.size ();
+							if (item.callback)
+							{
+								item.callback (ec, written);
+							}
 						}
-
-						this_l->send_queue.pop_front ();
+						this_l->writing = false;
 						if (!ec && !this_l->send_queue.empty ())
 						{
 							this_l->write_queued_messages ();
@@ -245,6 +262,7 @@ void nano::socket::close_internal ()
 		tcp_socket.shutdown (boost::asio::ip::tcp::socket::shutdown_both, ec);
 		tcp_socket.close (ec);
 		send_queue.clear ();
+		queued_bytes = 0;
 		if (ec)
 		{
 			if (auto node_l = node.lock ())
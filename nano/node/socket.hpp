@@ -56,6 +56,11 @@ public:
 	/** Change write concurrent */
 	void set_writer_concurrency (concurrency writer_concurrency_a);
 
+	/** Messages are dropped once this many bytes are waiting, a message is always accepted when nothing is queued */
+	static size_t constexpr queue_bytes_max = 64 * 1024;
+	/** Maximum number of queued messages combined into a single vectored write */
+	static size_t constexpr write_batch_max = 64;
+
 protected:
 	/** Holds the buffer and callback for queued writes */
 	class queue_item
@@ -73,14 +78,16 @@ protected:
 	boost::asio::ip::tcp::endpoint remote;
 	/** Send queue, protected by always being accessed in the strand */
 	std::deque<queue_item> send_queue;
+	/** Bytes queued or being written, accessed in the strand */
+	size_t queued_bytes{ 0 };
+	/** Set while a batch of queued messages is being written, accessed in the strand */
+	bool writing{ false };
 	std::atomic<concurrency> writer_concurrency;
 
 	std::atomic<uint64_t> next_deadline;
 	std::atomic<uint64_t> last_completion_time;
 	std::atomic<bool> timed_out{ false };
 	boost::optional<std::chrono::seconds> io_timeout;
-	size_t const queue_size_max = 128;
-
 	/** Set by close() - completion handlers must check this. This is more reliable than checking
 	 error codes as the OS may have already completed the async operation. */
 	std::atomic<bool> closed{ false };
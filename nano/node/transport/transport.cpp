@@ -85,12 +85,17 @@ node (node_a)
 	set_network_version (node_a.network_params.protocol.protocol_version);
 }
 
-void nano::transport::channel::send (nano::message const & message_a, std::function<void(boost::system::error_code const &, size_t)> const & callback_a, bool const is_droppable_a)
+nano::stat::detail nano::transport::message_detail (nano::message const & message_a)
 {
 	callback_visitor visitor;
 	message_a.visit (visitor);
+	return visitor.result;
+}
+
+void nano::transport::channel::send (nano::message const & message_a, std::function<void(boost::system::error_code const &, size_t)> const & callback_a, bool const is_droppable_a)
+{
 	auto buffer (message_a.to_shared_const_buffer ());
-	auto detail (visitor.result);
+	auto detail (nano::transport::message_detail (message_a));
 	node.network.limiter.add (buffer.size (), !is_droppable_a);
 	if (!is_droppable_a || !node.network.limiter.should_drop (buffer.size ()))
 	{
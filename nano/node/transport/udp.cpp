@@ -525,9 +525,13 @@ void nano::transport::udp_channels::receive_action (nano::message_buffer * data_
 	if (allowed_sender)
 	{
 		udp_message_visitor visitor (node, data_a->endpoint);
-		nano::message_parser parser (node.block_uniquer, node.vote_uniquer, visitor, node.work);
+		nano::message_parser parser (node.network.publish_filter, node.block_uniquer, node.vote_uniquer, visitor, node.work);
 		parser.deserialize_buffer (data_a->buffer, data_a->size);
-		if (parser.status != nano::message_parser::parse_status::success)
+		if (parser.status == nano::message_parser::parse_status::duplicate_publish_message)
+		{
+			node.stats.inc (nano::stat::type::filter, nano::stat::detail::duplicate_publish, nano::stat::dir::in);
+		}
+		else if (parser.status != nano::message_parser::parse_status::success)
 		{
 			node.stats.inc (nano::stat::type::error);
 
@@ -574,6 +578,7 @@ void nano::transport::udp_channels::receive_action (nano::message_buffer * data_
 					node.stats.inc (nano::stat::type::udp, nano::stat::detail::outdated_version);
 					break;
 				case nano::message_parser::parse_status::success:
+				case nano::message_parser::parse_status::duplicate_publish_message:
 					/* Already checked, unreachable */
 					break;
 			}
@@ -0,0 +1,175 @@
+#include <nano/node/unchecked_cache.hpp>
+#include <nano/secure/blockstore.hpp>
+
+#include <algorithm>
+
+namespace
+{
+bool key_less (nano::unchecked_key const & lhs, nano::unchecked_key const & rhs)
+{
+	return lhs.previous < rhs.previous || (lhs.previous == rhs.previous && lhs.hash < rhs.hash);
+}
+}
+
+nano::unchecked_cache::unchecked_cache (nano::block_store & store_a, size_t max_a) :
+store (store_a),
+max (max_a)
+{
+}
+
+nano::unchecked_cache::ordered_unchecked::index<nano::unchecked_cache::tag_dependency>::type::iterator nano::unchecked_cache::find (nano::unchecked_key const & key_a)
+{
+	auto & dependencies (entries.get<tag_dependency> ());
+	auto range (dependencies.equal_range (key_a.previous));
+	auto existing (std::find_if (range.first, range.second, [&key_a](nano::unchecked_entry const & entry_a) {
+		return entry_a.key.hash == key_a.hash;
+	}));
+	return existing != range.second ? existing : dependencies.end ();
+}
+
+bool nano::unchecked_cache::put (nano::write_transaction const & transaction_a, nano::unchecked_key const & key_a, nano::unchecked_info const & info_a)
+{
+	bool result (false);
+	nano::lock_guard<std::mutex> lock (mutex);
+	auto existing (find (key_a));
+	if (existing != entries.get<tag_dependency> ().end ())
+	{
+		entries.get<tag_dependency> ().modify (existing, [&info_a](nano::unchecked_entry & entry_a) {
+			entry_a.info = info_a;
+		});
+	}
+	else if (store.unchecked_exists (transaction_a, key_a))
+	{
+		// Already spilled, keep a single copy
+		store.unchecked_put (transaction_a, key_a, info_a);
+	}
+	else
+	{
+		result = true;
+		entries.get<tag_sequence> ().push_back (nano::unchecked_entry{ key_a.previous, key_a, info_a });
+		while (entries.size () > max)
+		{
+			auto const & oldest (entries.get<tag_sequence> ().front ());
+			store.unchecked_put (transaction_a, oldest.key, oldest.info);
+			entries.get<tag_sequence> ().pop_front ();
+		}
+	}
+	return result;
+}
+
+bool nano::unchecked_cache::exists (nano::transaction const & transaction_a, nano::unchecked_key const & key_a)
+{
+	{
+		nano::lock_guard<std::mutex> lock (mutex);
+		if (find (key_a) != entries.get<tag_dependency> ().end ())
+		{
+			return true;
+		}
+	}
+	return store.unchecked_exists (transaction_a, key_a);
+}
+
+std::vector<nano::unchecked_info> nano::unchecked_cache::get (nano::transaction const & transaction_a, nano::block_hash const & hash_a)
+{
+	std::vector<nano::unchecked_info> result;
+	{
+		nano::lock_guard<std::mutex> lock (mutex);
+		auto range (entries.get<tag_dependency> ().equal_range (hash_a));
+		for (auto i (range.first); i != range.second; ++i)
+		{
+			result.push_back (i->info);
+		}
+	}
+	auto stored (store.unchecked_get (transaction_a, hash_a));
+	result.insert (result.end (), stored.begin (), stored.end ());
+	return result;
+}
+
+bool nano::unchecked_cache::del (nano::write_transaction const & transaction_a, nano::unchecked_key const & key_a)
+{
+	{
+		nano::lock_guard<std::mutex> lock (mutex);
+		auto existing (find (key_a));
+		if (existing != entries.get<tag_dependency> ().end ())
+		{
+			entries.get<tag_dependency> ().erase (existing);
+			return false;
+		}
+	}
+	return store.unchecked_del (transaction_a, key_a);
+}
+
+void nano::unchecked_cache::clear (nano::write_transaction const & transaction_a)
+{
+	{
+		nano::lock_guard<std::mutex> lock (mutex);
+		entries.clear ();
+	}
+	store.unchecked_clear (transaction_a);
+}
+
+size_t nano::unchecked_cache::count (nano::transaction const & transaction_a)
+{
+	return size () + store.unchecked_count (transaction_a);
+}
+
+void nano::unchecked_cache::flush (nano::write_transaction const & transaction_a)
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	for (auto const & entry : entries.get<tag_sequence> ())
+	{
+		store.unchecked_put (transaction_a, entry.key, entry.info);
+	}
+	entries.clear ();
+}
+
+void nano::unchecked_cache::for_each (nano::transaction const & transaction_a, std::function<bool(nano::unchecked_key const &, nano::unchecked_info const &)> const & action_a, nano::unchecked_key const & start_a)
+{
+	// Snapshot the memory entries so the action runs without holding the mutex
+	std::vector<nano::unchecked_entry> memory;
+	{
+		nano::lock_guard<std::mutex> lock (mutex);
+		for (auto const & entry : entries.get<tag_sequence> ())
+		{
+			if (!key_less (entry.key, start_a))
+			{
+				memory.push_back (entry);
+			}
+		}
+	}
+	std::sort (memory.begin (), memory.end (), [](nano::unchecked_entry const & lhs, nano::unchecked_entry const & rhs) {
+		return key_less (lhs.key, rhs.key);
+	});
+	auto m (memory.begin ());
+	auto i (store.unchecked_begin (transaction_a, start_a));
+	auto n (store.unchecked_end ());
+	auto proceed (true);
+	while (proceed && (m != memory.end () || i != n))
+	{
+		if (i == n || (m != memory.end () && key_less (m->key, i->first)))
+		{
+			proceed = action_a (m->key, m->info);
+			++m;
+		}
+		else
+		{
+			proceed = action_a (i->first, i->second);
+			++i;
+		}
+	}
+}
+
+size_t nano::unchecked_cache::size ()
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	return entries.size ();
+}
+
+std::unique_ptr<nano::container_info_component> nano::collect_container_info (unchecked_cache & unchecked_cache, const std::string & name)
+{
+	auto count = unchecked_cache.size ();
+	auto sizeof_element = sizeof (decltype (unchecked_cache.entries)::value_type);
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "entries", count, sizeof_element }));
+	return composite;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <nano/lib/numbers.hpp>
+#include <nano/lib/utility.hpp>
+#include <nano/secure/common.hpp>
+
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+#include <boost/multi_index_container.hpp>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace nano
+{
+class block_store;
+class transaction;
+class write_transaction;
+
+/** An unchecked block together with the dependency (previous or source) it is waiting on */
+class unchecked_entry final
+{
+public:
+	nano::block_hash dependency;
+	nano::unchecked_key key;
+	nano::unchecked_info info;
+};
+
+/**
+ * Holds unchecked blocks in memory, keyed by the block they depend on, in front of the unchecked table.
+ * Entries are only written to the store when the cache overflows (oldest first) or when flushed at shutdown.
+ * Callers remain responsible for keeping ledger.cache.unchecked_count in sync, as with the store functions.
+ */
+class unchecked_cache final
+{
+public:
+	unchecked_cache (nano::block_store &, size_t);
+	/** Returns true if the key was not previously known */
+	bool put (nano::write_transaction const &, nano::unchecked_key const &, nano::unchecked_info const &);
+	bool exists (nano::transaction const &, nano::unchecked_key const &);
+	std::vector<nano::unchecked_info> get (nano::transaction const &, nano::block_hash const &);
+	/** Returns true if the key was not found, matching block_store::unchecked_del */
+	bool del (nano::write_transaction const &, nano::unchecked_key const &);
+	void clear (nano::write_transaction const &);
+	size_t count (nano::transaction const &);
+	/** Writes every in-memory entry to the store */
+	void flush (nano::write_transaction const &);
+	/** Visits entries from memory and the store in key order starting at the given key, stopping when the action returns false */
+	void for_each (nano::transaction const &, std::function<bool(nano::unchecked_key const &, nano::unchecked_info const &)> const &, nano::unchecked_key const & = nano::unchecked_key (0, 0));
+	size_t size ();
+
+private:
+	// clang-format off
+	class tag_sequence {};
+	class tag_dependency {};
+	using ordered_unchecked = boost::multi_index_container<nano::unchecked_entry,
+	boost::multi_index::indexed_by<
+		boost::multi_index::sequenced<boost::multi_index::tag<tag_sequence>>,
+		boost::multi_index::hashed_non_unique<boost::multi_index::tag<tag_dependency>,
+			boost::multi_index::member<nano::unchecked_entry, nano::block_hash, &nano::unchecked_entry::dependency>>>>;
+	// clang-format on
+	ordered_unchecked::index<tag_dependency>::type::iterator find (nano::unchecked_key const &);
+	nano::block_store & store;
+	ordered_unchecked entries;
+	std::mutex mutex;
+
+public:
+	size_t const max;
+	friend std::unique_ptr<container_info_component> collect_container_info (unchecked_cache &, const std::string &);
+};
+
+std::unique_ptr<container_info_component> collect_container_info (unchecked_cache & unchecked_cache, const std::string & name);
+}
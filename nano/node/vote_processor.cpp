@@ -15,6 +15,8 @@
 
 #include <boost/format.hpp>
 
+#include <algorithm>
+
 nano::vote_processor::vote_processor (nano::signature_checker & checker_a, nano::active_transactions & active_a, nano::node_observers & observers_a, nano::stat & stats_a, nano::node_config & config_a, nano::logger_mt & logger_a, nano::online_reps & online_reps_a, nano::ledger & ledger_a, nano::network_params & network_params_a) :
 checker (checker_a),
 active (active_a),
@@ -142,39 +144,114 @@ void nano::vote_processor::vote (std::shared_ptr<nano::vote> vote_a, std::shared
 
 void nano::vote_processor::verify_votes (decltype (votes) const & votes_a)
 {
+	/*
+	 * Votes which every targeted election would reject as a replay are dropped before signature checking, unless replays are observed
+	 * Votes identical to one verified recently, including the signature, are processed without checking it again
+	 */
+	enum class status : uint8_t
+	{
+		unchecked,
+		filtered,
+		known
+	};
 	auto size (votes_a.size ());
+	std::vector<status> statuses (size, status::unchecked);
+	std::vector<nano::block_hash> full_hashes;
+	full_hashes.reserve (size);
+	if (!replay_observed || !replay_observed ())
+	{
+		nano::lock_guard<std::mutex> active_guard (active.mutex);
+		auto i (0);
+		for (auto const & vote : votes_a)
+		{
+			if (active.replay (*vote.first))
+			{
+				statuses[i] = status::filtered;
+			}
+			++i;
+		}
+	}
+	for (auto const & vote : votes_a)
+	{
+		full_hashes.push_back (vote.first->full_hash ());
+	}
+	{
+		nano::lock_guard<std::mutex> guard (mutex);
+		for (size_t i (0); i < size; ++i)
+		{
+			if (statuses[i] == status::unchecked && verified_votes.get<tag_hash> ().find (full_hashes[i]) != verified_votes.get<tag_hash> ().end ())
+			{
+				statuses[i] = status::known;
+			}
+		}
+	}
+	size_t unchecked_count (std::count (statuses.begin (), statuses.end (), status::unchecked));
 	std::vector<unsigned char const *> messages;
-	messages.reserve (size);
+	messages.reserve (unchecked_count);
 	std::vector<nano::block_hash> hashes;
-	hashes.reserve (size);
-	std::vector<size_t> lengths (size, sizeof (nano::block_hash));
+	hashes.reserve (unchecked_count);
+	std::vector<size_t> lengths (unchecked_count, sizeof (nano::block_hash));
 	std::vector<unsigned char const *> pub_keys;
-	pub_keys.reserve (size);
+	pub_keys.reserve (unchecked_count);
 	std::vector<unsigned char const *> signatures;
-	signatures.reserve (size);
+	signatures.reserve (unchecked_count);
 	std::vector<int> verifications;
-	verifications.resize (size);
+	verifications.resize (unchecked_count);
+	auto i (0);
 	for (auto const & vote : votes_a)
 	{
-		hashes.push_back (vote.first->hash ());
-		messages.push_back (hashes.back ().bytes.data ());
-		pub_keys.push_back (vote.first->account.bytes.data ());
-		signatures.push_back (vote.first->signature.bytes.data ());
+		if (statuses[i] == status::unchecked)
+		{
+			hashes.push_back (vote.first->hash ());
+			messages.push_back (hashes.back ().bytes.data ());
+			pub_keys.push_back (vote.first->account.bytes.data ());
+			signatures.push_back (vote.first->signature.bytes.data ());
+		}
+		++i;
+	}
+	if (unchecked_count > 0)
+	{
+		nano::signature_check_set check = { unchecked_count, messages.data (), lengths.data (), pub_keys.data (), signatures.data (), verifications.data () };
+		checker.verify (check);
 	}
-	nano::signature_check_set check = { size, messages.data (), lengths.data (), pub_keys.data (), signatures.data (), verifications.data () };
-	checker.verify (check);
-	auto i (0);
+	stats.add (nano::stat::type::vote, nano::stat::detail::vote_signature_checked, nano::stat::dir::in, unchecked_count);
+	i = 0;
+	auto checked (0);
 	for (auto const & vote : votes_a)
 	{
-		assert (verifications[i] == 1 || verifications[i] == 0);
-		if (verifications[i] == 1)
+		switch (statuses[i])
 		{
-			vote_blocking (vote.first, vote.second, true);
+			case status::unchecked:
+				assert (verifications[checked] == 1 || verifications[checked] == 0);
+				if (verifications[checked] == 1)
+				{
+					add_verified (full_hashes[i]);
+					vote_blocking (vote.first, vote.second, true);
+				}
+				++checked;
+				break;
+			case status::known:
+				stats.inc (nano::stat::type::vote, nano::stat::detail::vote_signature_known);
+				vote_blocking (vote.first, vote.second, true);
+				break;
+			case status::filtered:
+				stats.inc (nano::stat::type::vote, nano::stat::detail::vote_filtered_replay);
+				stats.inc (nano::stat::type::vote, nano::stat::detail::vote_replay);
+				break;
 		}
 		++i;
 	}
 }
 
+void nano::vote_processor::add_verified (nano::block_hash const & full_hash_a)
+{
+	nano::lock_guard<std::mutex> guard (mutex);
+	if (verified_votes.get<tag_sequence> ().push_back (full_hash_a).second && verified_votes.size () > verified_votes_max)
+	{
+		verified_votes.get<tag_sequence> ().pop_front ();
+	}
+}
+
 // node.active.mutex lock required
 nano::vote_code nano::vote_processor::vote_blocking (std::shared_ptr<nano::vote> vote_a, std::shared_ptr<nano::transport::channel> channel_a, bool validated)
 {
@@ -269,6 +346,7 @@ std::unique_ptr<nano::container_info_component> nano::collect_container_info (vo
 	size_t representatives_1_count;
 	size_t representatives_2_count;
 	size_t representatives_3_count;
+	size_t verified_votes_count;
 
 	{
 		nano::lock_guard<std::mutex> guard (vote_processor.mutex);
@@ -276,6 +354,7 @@ std::unique_ptr<nano::container_info_component> nano::collect_container_info (vo
 		representatives_1_count = vote_processor.representatives_1.size ();
 		representatives_2_count = vote_processor.representatives_2.size ();
 		representatives_3_count = vote_processor.representatives_3.size ();
+		verified_votes_count = vote_processor.verified_votes.size ();
 	}
 
 	auto composite = std::make_unique<container_info_composite> (name);
@@ -283,5 +362,6 @@ std::unique_ptr<nano::container_info_component> nano::collect_container_info (vo
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "representatives_1", representatives_1_count, sizeof (decltype (vote_processor.representatives_1)::value_type) }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "representatives_2", representatives_2_count, sizeof (decltype (vote_processor.representatives_2)::value_type) }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "representatives_3", representatives_3_count, sizeof (decltype (vote_processor.representatives_3)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "verified_votes", verified_votes_count, sizeof (decltype (vote_processor.verified_votes)::value_type) }));
 	return composite;
 }
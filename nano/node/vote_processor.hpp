@@ -4,7 +4,13 @@
 #include <nano/lib/utility.hpp>
 #include <nano/secure/common.hpp>
 
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/identity.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+#include <boost/multi_index_container.hpp>
+
 #include <deque>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -31,6 +37,11 @@ namespace transport
 
 class vote_processor final
 {
+	// clang-format off
+	class tag_sequence {};
+	class tag_hash {};
+	// clang-format on
+
 public:
 	explicit vote_processor (nano::signature_checker & checker_a, nano::active_transactions & active_a, nano::node_observers & observers_a, nano::stat & stats_a, nano::node_config & config_a, nano::logger_mt & logger_a, nano::online_reps & online_reps_a, nano::ledger & ledger_a, nano::network_params & network_params_a);
 	void vote (std::shared_ptr<nano::vote>, std::shared_ptr<nano::transport::channel>);
@@ -40,9 +51,12 @@ public:
 	void flush ();
 	void calculate_weights ();
 	void stop ();
+	/** If set and returning true, replays are observed, so votes are verified and notified even when every election would reject them */
+	std::function<bool()> replay_observed;
 
 private:
 	void process_loop ();
+	void add_verified (nano::block_hash const &);
 
 	nano::signature_checker & checker;
 	nano::active_transactions & active;
@@ -59,6 +73,16 @@ private:
 	std::unordered_set<nano::account> representatives_1;
 	std::unordered_set<nano::account> representatives_2;
 	std::unordered_set<nano::account> representatives_3;
+	/** Full hashes of recently verified votes, so identical copies skip signature checking */
+	// clang-format off
+	boost::multi_index_container<nano::block_hash,
+	boost::multi_index::indexed_by<
+		boost::multi_index::sequenced<boost::multi_index::tag<tag_sequence>>,
+		boost::multi_index::hashed_unique<boost::multi_index::tag<tag_hash>,
+			boost::multi_index::identity<nano::block_hash>>>>
+	verified_votes;
+	// clang-format on
+	static size_t constexpr verified_votes_max{ 64 * 1024 };
 	nano::condition_variable condition;
 	std::mutex mutex;
 	bool started;
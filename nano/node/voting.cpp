@@ -10,7 +10,9 @@
 
 #include <boost/variant/get.hpp>
 
+#include <algorithm>
 #include <chrono>
+#include <future>
 
 nano::vote_generator::vote_generator (nano::node_config & config_a, nano::block_store & store_a, nano::wallets & wallets_a, nano::vote_processor & vote_processor_a, nano::votes_cache & votes_cache_a, nano::network & network_a) :
 config (config_a),
@@ -19,6 +21,7 @@ wallets (wallets_a),
 vote_processor (vote_processor_a),
 votes_cache (votes_cache_a),
 network (network_a),
+signing_threads (std::max (1U, std::min (config_a.signature_checker_threads, max_signing_threads))),
 thread ([this]() { run (); })
 {
 	nano::unique_lock<std::mutex> lock (mutex);
@@ -48,6 +51,11 @@ void nano::vote_generator::stop ()
 	{
 		thread.join ();
 	}
+	// Only the generator thread starts the pool, it has exited
+	if (thread_pool != nullptr)
+	{
+		thread_pool->join ();
+	}
 }
 
 void nano::vote_generator::send (nano::unique_lock<std::mutex> & lock_a)
@@ -61,16 +69,71 @@ void nano::vote_generator::send (nano::unique_lock<std::mutex> & lock_a)
 	}
 	lock_a.unlock ();
 	{
-		auto transaction (store.tx_begin_read ());
-		wallets.foreach_representative ([this, &hashes_l, &transaction](nano::public_key const & pub_a, nano::raw_key const & prv_a) {
-			auto vote (this->store.vote_generate (transaction, pub_a, prv_a, hashes_l));
-			this->vote_processor.vote (vote, std::make_shared<nano::transport::channel_udp> (this->network.udp_channels, this->network.endpoint (), this->network_params.protocol.protocol_version));
-			this->votes_cache.add (vote);
+		std::vector<std::pair<nano::account, nano::raw_key>> representatives;
+		wallets.foreach_representative ([&representatives](nano::public_key const & pub_a, nano::raw_key const & prv_a) {
+			// A representative can be present in more than one wallet
+			auto existing (std::find_if (representatives.begin (), representatives.end (), [&pub_a](auto const & representative_a) {
+				return representative_a.first == pub_a;
+			}));
+			if (existing == representatives.end ())
+			{
+				representatives.emplace_back (pub_a, prv_a);
+			}
 		});
+		if (!representatives.empty ())
+		{
+			if (channel == nullptr)
+			{
+				channel = std::make_shared<nano::transport::channel_udp> (network.udp_channels, network.endpoint (), network_params.protocol.protocol_version);
+			}
+			std::vector<std::shared_ptr<nano::vote>> votes;
+			{
+				auto transaction (store.tx_begin_read ());
+				votes = store.vote_generate (transaction, representatives, hashes_l, [this](std::vector<std::function<void()>> const & tasks_a) {
+					sign (tasks_a);
+				});
+			}
+			for (auto const & vote : votes)
+			{
+				vote_processor.vote (vote, channel);
+				votes_cache.add (vote);
+			}
+		}
 	}
 	lock_a.lock ();
 }
 
+void nano::vote_generator::sign (std::vector<std::function<void()>> const & tasks_a)
+{
+	if (tasks_a.size () > 1)
+	{
+		if (thread_pool == nullptr)
+		{
+			thread_pool = std::make_unique<boost::asio::thread_pool> (signing_threads);
+			nano::thread_role::set (*thread_pool, signing_threads, nano::thread_role::name::voting_signing);
+		}
+		std::atomic<size_t> pending (tasks_a.size () - 1);
+		std::promise<void> promise;
+		auto future (promise.get_future ());
+		for (auto i (tasks_a.begin () + 1), n (tasks_a.end ()); i != n; ++i)
+		{
+			boost::asio::post (*thread_pool, [& task = *i, &pending, &promise]() {
+				task ();
+				if (--pending == 0)
+				{
+					promise.set_value ();
+				}
+			});
+		}
+		tasks_a.front () ();
+		future.wait ();
+	}
+	else if (!tasks_a.empty ())
+	{
+		tasks_a.front () ();
+	}
+}
+
 void nano::vote_generator::run ()
 {
 	nano::thread_role::set (nano::thread_role::name::voting);
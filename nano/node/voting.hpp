@@ -1,5 +1,6 @@
 #pragma once
 
+#include <nano/boost/asio/thread_pool.hpp>
 #include <nano/lib/locks.hpp>
 #include <nano/lib/numbers.hpp>
 #include <nano/lib/utility.hpp>
@@ -25,6 +26,10 @@ class node_config;
 class vote_processor;
 class votes_cache;
 class wallets;
+namespace transport
+{
+	class channel_udp;
+}
 
 class vote_generator final
 {
@@ -36,6 +41,8 @@ public:
 private:
 	void run ();
 	void send (nano::unique_lock<std::mutex> &);
+	/** Runs the signing tasks on the thread pool and the calling thread, returning once all have finished */
+	void sign (std::vector<std::function<void()>> const &);
 	nano::node_config & config;
 	nano::block_store & store;
 	nano::wallets & wallets;
@@ -48,8 +55,17 @@ private:
 	nano::network_params network_params;
 	bool stopped{ false };
 	bool started{ false };
+	/** Loopback channel attributed to locally generated votes, created on first use */
+	std::shared_ptr<nano::transport::channel_udp> channel;
+	unsigned const signing_threads;
+	/** Only started once votes are signed for more than one representative, so nodes hosting none or one don't keep idle threads */
+	std::unique_ptr<boost::asio::thread_pool> thread_pool;
 	std::thread thread;
 
+public:
+	/** Signing is cheap compared to the rest of vote processing, a few threads are enough to keep up with many hosted representatives */
+	static unsigned constexpr max_signing_threads{ 4 };
+
 	friend std::unique_ptr<container_info_component> collect_container_info (vote_generator & vote_generator, const std::string & name);
 };
 
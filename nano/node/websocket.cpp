@@ -1,6 +1,7 @@
 #include <nano/boost/asio/bind_executor.hpp>
 #include <nano/boost/asio/dispatch.hpp>
 #include <nano/boost/asio/strand.hpp>
+#include <nano/lib/stats.hpp>
 #include <nano/lib/work.hpp>
 #include <nano/node/active_transactions.hpp>
 #include <nano/node/wallet.hpp>
@@ -64,19 +65,9 @@ wallets (wallets_a)
 	if (accounts_l)
 	{
 		has_account_filtering_options = true;
-		for (auto account_l : *accounts_l)
-		{
-			nano::account result_l (0);
-			if (!result_l.decode_account (account_l.second.data ()))
-			{
-				// Do not insert the given raw data to keep old prefix support
-				accounts.insert (result_l.to_account ());
-			}
-			else
-			{
-				logger_a.always_log ("Websocket: invalid account provided for filtering blocks: ", account_l.second.data ());
-			}
-		}
+		accounts.reserve (accounts_l->size ());
+		std::vector<nano::account> added_l;
+		update_accounts (*accounts_l, true, logger_a, added_l);
 
 		if (!include_block)
 		{
@@ -110,24 +101,23 @@ bool nano::websocket::confirmation_options::should_filter (nano::websocket::mess
 
 	bool should_filter_account (has_account_filtering_options);
 	auto destination_opt_l (message_a.contents.get_optional<std::string> ("message.block.link_as_account"));
-	if (destination_opt_l)
+	if (has_account_filtering_options && destination_opt_l)
 	{
-		auto source_text_l (message_a.contents.get<std::string> ("message.account"));
+		nano::account source_l (0), destination_l (0);
+		auto decode_source_ok_l (!source_l.decode_account (message_a.contents.get<std::string> ("message.account")));
+		auto decode_destination_ok_l (!destination_l.decode_account (destination_opt_l.get ()));
+		(void)decode_source_ok_l;
+		(void)decode_destination_ok_l;
+		assert (decode_source_ok_l && decode_destination_ok_l);
 		if (all_local_accounts)
 		{
 			auto transaction_l (wallets.tx_begin_read ());
-			nano::account source_l (0), destination_l (0);
-			auto decode_source_ok_l (!source_l.decode_account (source_text_l));
-			auto decode_destination_ok_l (!destination_l.decode_account (destination_opt_l.get ()));
-			(void)decode_source_ok_l;
-			(void)decode_destination_ok_l;
-			assert (decode_source_ok_l && decode_destination_ok_l);
 			if (wallets.exists (transaction_l, source_l) || wallets.exists (transaction_l, destination_l))
 			{
 				should_filter_account = false;
 			}
 		}
-		if (accounts.find (source_text_l) != accounts.end () || accounts.find (destination_opt_l.get ()) != accounts.end ())
+		if (accounts.find (source_l) != accounts.end () || accounts.find (destination_l) != accounts.end ())
 		{
 			should_filter_account = false;
 		}
@@ -136,6 +126,42 @@ bool nano::websocket::confirmation_options::should_filter (nano::websocket::mess
 	return should_filter_conf_type_l || should_filter_account;
 }
 
+void nano::websocket::confirmation_options::update (boost::property_tree::ptree const & options_a, nano::logger_mt & logger_a, std::vector<nano::account> & added_a, std::vector<nano::account> & removed_a)
+{
+	auto accounts_add_l (options_a.get_child_optional ("accounts_add"));
+	if (accounts_add_l)
+	{
+		has_account_filtering_options = true;
+		accounts.reserve (accounts.size () + accounts_add_l->size ());
+		update_accounts (*accounts_add_l, true, logger_a, added_a);
+	}
+	auto accounts_del_l (options_a.get_child_optional ("accounts_del"));
+	if (accounts_del_l)
+	{
+		update_accounts (*accounts_del_l, false, logger_a, removed_a);
+	}
+}
+
+void nano::websocket::confirmation_options::update_accounts (boost::property_tree::ptree const & accounts_a, bool insert_a, nano::logger_mt & logger_a, std::vector<nano::account> & changed_a)
+{
+	for (auto const & account_l : accounts_a)
+	{
+		nano::account result_l (0);
+		if (!result_l.decode_account (account_l.second.data ()))
+		{
+			auto changed_l (insert_a ? accounts.insert (result_l).second : accounts.erase (result_l) > 0);
+			if (changed_l)
+			{
+				changed_a.push_back (result_l);
+			}
+		}
+		else
+		{
+			logger_a.always_log ("Websocket: invalid account provided for filtering blocks: ", account_l.second.data ());
+		}
+	}
+}
+
 nano::websocket::vote_options::vote_options (boost::property_tree::ptree const & options_a, nano::logger_mt & logger_a)
 {
 	include_replays = options_a.get<bool> ("include_replays", false);
@@ -179,6 +205,97 @@ bool nano::websocket::vote_options::should_filter (nano::websocket::message cons
 	return should_filter_l;
 }
 
+void nano::websocket::confirmation_index::insert (std::shared_ptr<nano::websocket::session> const & session_a, std::unordered_set<nano::account> const * accounts_a)
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	auto session_l (session_a.get ());
+	sessions[session_l] = session_a;
+	if (accounts_a == nullptr)
+	{
+		unindexed.insert (session_l);
+	}
+	else
+	{
+		for (auto const & account_l : *accounts_a)
+		{
+			accounts[account_l].insert (session_l);
+		}
+	}
+}
+
+void nano::websocket::confirmation_index::erase (nano::websocket::session const & session_a, std::unordered_set<nano::account> const * accounts_a)
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	sessions.erase (&session_a);
+	if (accounts_a == nullptr)
+	{
+		unindexed.erase (&session_a);
+	}
+	else
+	{
+		for (auto const & account_l : *accounts_a)
+		{
+			erase_account (session_a, account_l);
+		}
+	}
+}
+
+void nano::websocket::confirmation_index::update (nano::websocket::session const & session_a, std::vector<nano::account> const & added_a, std::vector<nano::account> const & removed_a)
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	// Same order as confirmation_options::update, an account can be in both lists
+	for (auto const & account_l : added_a)
+	{
+		accounts[account_l].insert (&session_a);
+	}
+	for (auto const & account_l : removed_a)
+	{
+		erase_account (session_a, account_l);
+	}
+}
+
+void nano::websocket::confirmation_index::erase_account (nano::websocket::session const & session_a, nano::account const & account_a)
+{
+	auto existing (accounts.find (account_a));
+	if (existing != accounts.end ())
+	{
+		existing->second.erase (&session_a);
+		if (existing->second.empty ())
+		{
+			accounts.erase (existing);
+		}
+	}
+}
+
+std::vector<std::shared_ptr<nano::websocket::session>> nano::websocket::confirmation_index::find (std::vector<nano::account> const & accounts_a)
+{
+	// Declared before the lock so that sessions released here are destroyed after it is unlocked
+	std::vector<std::shared_ptr<nano::websocket::session>> result;
+	nano::lock_guard<std::mutex> lock (mutex);
+	std::unordered_set<nano::websocket::session const *> candidates (unindexed);
+	for (auto const & account_l : accounts_a)
+	{
+		auto existing (accounts.find (account_l));
+		if (existing != accounts.end ())
+		{
+			candidates.insert (existing->second.begin (), existing->second.end ());
+		}
+	}
+	for (auto candidate : candidates)
+	{
+		auto existing (sessions.find (candidate));
+		if (existing != sessions.end ())
+		{
+			auto session_l (existing->second.lock ());
+			if (session_l)
+			{
+				result.push_back (std::move (session_l));
+			}
+		}
+	}
+	return result;
+}
+
 nano::websocket::session::session (nano::websocket::listener & listener_a, socket_type socket_a) :
 ws_listener (listener_a), ws (std::move (socket_a)), strand (ws.get_executor ())
 {
@@ -192,6 +309,10 @@ nano::websocket::session::~session ()
 		nano::unique_lock<std::mutex> lk (subscriptions_mutex);
 		for (auto & subscription : subscriptions)
 		{
+			if (subscription.first == nano::websocket::topic::confirmation)
+			{
+				unindex_confirmation (*subscription.second);
+			}
 			ws_listener.decrease_subscriber_count (subscription.first);
 		}
 	}
@@ -228,32 +349,62 @@ void nano::websocket::session::close ()
 	});
 }
 
-void nano::websocket::session::write (nano::websocket::message message_a)
+bool nano::websocket::session::should_write (nano::websocket::message const & message_a)
 {
-	nano::unique_lock<std::mutex> lk (subscriptions_mutex);
+	nano::lock_guard<std::mutex> lk (subscriptions_mutex);
 	auto subscription (subscriptions.find (message_a.topic));
-	if (message_a.topic == nano::websocket::topic::ack || (subscription != subscriptions.end () && !subscription->second->should_filter (message_a)))
+	return message_a.topic == nano::websocket::topic::ack || (subscription != subscriptions.end () && !subscription->second->should_filter (message_a));
+}
+
+void nano::websocket::session::write (nano::websocket::message const & message_a)
+{
+	if (should_write (message_a))
 	{
-		lk.unlock ();
-		auto this_l (shared_from_this ());
-		boost::asio::post (strand,
-		[message_a, this_l]() {
+		write (message_a.to_buffer ());
+	}
+}
+
+void nano::websocket::session::write (nano::shared_const_buffer const & buffer_a)
+{
+	auto this_l (shared_from_this ());
+	boost::asio::post (strand,
+	[buffer_a, this_l]() {
+		if (this_l->overflowed)
+		{
+			return;
+		}
+		auto & listener_l (this_l->ws_listener);
+		if (this_l->send_queue.size () < listener_l.config.send_queue_max)
+		{
 			bool write_in_progress = !this_l->send_queue.empty ();
-			this_l->send_queue.emplace_back (message_a);
+			this_l->send_queue.push_back (buffer_a);
 			if (!write_in_progress)
 			{
 				this_l->write_queued_messages ();
 			}
-		});
-	}
+		}
+		else
+		{
+			// The consumer is not keeping up
+			listener_l.stats.inc (nano::stat::type::websocket, nano::stat::detail::message_drop, nano::stat::dir::out);
+			if (listener_l.config.overflow_policy == nano::websocket::overflow_policy::disconnect)
+			{
+				this_l->overflowed = true;
+				listener_l.stats.inc (nano::stat::type::websocket, nano::stat::detail::session_overflow, nano::stat::dir::out);
+				listener_l.get_logger ().try_log ("Websocket: closing session, send queue is full");
+				// Closing the underlying socket aborts the pending write and read, ending the session
+				boost::system::error_code ec_ignore;
+				this_l->ws.next_layer ().close (ec_ignore);
+			}
+		}
+	});
 }
 
 void nano::websocket::session::write_queued_messages ()
 {
-	auto msg (send_queue.front ().to_string ());
 	auto this_l (shared_from_this ());
 
-	ws.async_write (nano::shared_const_buffer (msg),
+	ws.async_write (send_queue.front (),
 	boost::asio::bind_executor (strand,
 	[this_l](boost::system::error_code ec, std::size_t bytes_transferred) {
 		this_l->send_queue.pop_front ();
@@ -414,9 +565,14 @@ void nano::websocket::session::handle_message (boost::property_tree::ptree const
 		{
 			options_l = std::make_unique<nano::websocket::options> ();
 		}
+		auto & new_options_l (*options_l);
 		auto existing (subscriptions.find (topic_l));
 		if (existing != subscriptions.end ())
 		{
+			if (topic_l == nano::websocket::topic::confirmation)
+			{
+				unindex_confirmation (*existing->second);
+			}
 			existing->second = std::move (options_l);
 			ws_listener.get_logger ().always_log ("Websocket: updated subscription to topic: ", from_topic (topic_l));
 		}
@@ -426,13 +582,59 @@ void nano::websocket::session::handle_message (boost::property_tree::ptree const
 			ws_listener.get_logger ().always_log ("Websocket: new subscription to topic: ", from_topic (topic_l));
 			ws_listener.increase_subscriber_count (topic_l);
 		}
+		if (topic_l == nano::websocket::topic::confirmation)
+		{
+			index_confirmation (new_options_l);
+		}
 		action_succeeded = true;
 	}
+	else if (action == "update" && topic_l == nano::websocket::topic::confirmation)
+	{
+		auto options_text_l (message_a.get_child_optional ("options"));
+		nano::lock_guard<std::mutex> lk (subscriptions_mutex);
+		auto existing (subscriptions.find (topic_l));
+		if (options_text_l && existing != subscriptions.end ())
+		{
+			auto conf_options (dynamic_cast<nano::websocket::confirmation_options *> (existing->second.get ()));
+			auto indexed_l (conf_options != nullptr && conf_options->filters_by_account_list ());
+			if (!indexed_l)
+			{
+				// The session may become indexed by account, register it again once updated
+				unindex_confirmation (*existing->second);
+				if (conf_options == nullptr)
+				{
+					// Subscribed without options, start from the defaults
+					auto defaults_l (std::make_unique<nano::websocket::confirmation_options> (ws_listener.get_wallets ()));
+					conf_options = defaults_l.get ();
+					existing->second = std::move (defaults_l);
+				}
+			}
+			std::vector<nano::account> added_l;
+			std::vector<nano::account> removed_l;
+			conf_options->update (options_text_l.get (), ws_listener.get_logger (), added_l, removed_l);
+			if (indexed_l)
+			{
+				ws_listener.confirmation_sessions.update (*this, added_l, removed_l);
+			}
+			else
+			{
+				index_confirmation (*conf_options);
+			}
+			ws_listener.get_logger ().always_log ("Websocket: updated subscription to topic: ", from_topic (topic_l));
+			action_succeeded = true;
+		}
+	}
 	else if (action == "unsubscribe" && topic_l != nano::websocket::topic::invalid)
 	{
 		nano::lock_guard<std::mutex> lk (subscriptions_mutex);
-		if (subscriptions.erase (topic_l))
+		auto existing (subscriptions.find (topic_l));
+		if (existing != subscriptions.end ())
 		{
+			if (topic_l == nano::websocket::topic::confirmation)
+			{
+				unindex_confirmation (*existing->second);
+			}
+			subscriptions.erase (existing);
 			ws_listener.get_logger ().always_log ("Websocket: removed subscription to topic: ", from_topic (topic_l));
 			ws_listener.decrease_subscriber_count (topic_l);
 		}
@@ -450,6 +652,20 @@ void nano::websocket::session::handle_message (boost::property_tree::ptree const
 	}
 }
 
+void nano::websocket::session::index_confirmation (nano::websocket::options const & options_a)
+{
+	auto conf_options (dynamic_cast<nano::websocket::confirmation_options const *> (&options_a));
+	auto accounts_l (conf_options != nullptr && conf_options->filters_by_account_list () ? &conf_options->get_accounts () : nullptr);
+	ws_listener.confirmation_sessions.insert (shared_from_this (), accounts_l);
+}
+
+void nano::websocket::session::unindex_confirmation (nano::websocket::options const & options_a)
+{
+	auto conf_options (dynamic_cast<nano::websocket::confirmation_options const *> (&options_a));
+	auto accounts_l (conf_options != nullptr && conf_options->filters_by_account_list () ? &conf_options->get_accounts () : nullptr);
+	ws_listener.confirmation_sessions.erase (*this, accounts_l);
+}
+
 void nano::websocket::listener::stop ()
 {
 	stopped = true;
@@ -467,9 +683,11 @@ void nano::websocket::listener::stop ()
 	sessions.clear ();
 }
 
-nano::websocket::listener::listener (nano::logger_mt & logger_a, nano::wallets & wallets_a, boost::asio::io_context & io_ctx_a, boost::asio::ip::tcp::endpoint endpoint_a) :
+nano::websocket::listener::listener (nano::websocket::config const & config_a, nano::logger_mt & logger_a, nano::wallets & wallets_a, nano::stat & stats_a, boost::asio::io_context & io_ctx_a, boost::asio::ip::tcp::endpoint endpoint_a) :
+config (config_a),
 logger (logger_a),
 wallets (wallets_a),
+stats (stats_a),
 acceptor (io_ctx_a),
 socket (io_ctx_a)
 {
@@ -531,53 +749,67 @@ void nano::websocket::listener::broadcast_confirmation (std::shared_ptr<nano::bl
 {
 	nano::websocket::message_builder builder;
 
-	nano::lock_guard<std::mutex> lk (sessions_mutex);
+	// Account filters match either the block account or, for state blocks, the link as an account
+	std::vector<nano::account> accounts_l{ account_a };
+	if (block_a->type () == nano::block_type::state)
+	{
+		accounts_l.push_back (block_a->link ().account);
+	}
+
 	boost::optional<nano::websocket::message> msg_with_block;
 	boost::optional<nano::websocket::message> msg_without_block;
-	for (auto & weak_session : sessions)
+	boost::optional<nano::shared_const_buffer> buffer_with_block;
+	boost::optional<nano::shared_const_buffer> buffer_without_block;
+	for (auto & session_ptr : confirmation_sessions.find (accounts_l))
 	{
-		auto session_ptr (weak_session.lock ());
-		if (session_ptr)
+		nano::unique_lock<std::mutex> lk (session_ptr->subscriptions_mutex);
+		auto subscription (session_ptr->subscriptions.find (nano::websocket::topic::confirmation));
+		if (subscription != session_ptr->subscriptions.end ())
 		{
-			auto subscription (session_ptr->subscriptions.find (nano::websocket::topic::confirmation));
-			if (subscription != session_ptr->subscriptions.end ())
+			nano::websocket::confirmation_options default_options (wallets);
+			auto conf_options (dynamic_cast<nano::websocket::confirmation_options *> (subscription->second.get ()));
+			if (conf_options == nullptr)
 			{
-				nano::websocket::confirmation_options default_options (wallets);
-				auto conf_options (dynamic_cast<nano::websocket::confirmation_options *> (subscription->second.get ()));
-				if (conf_options == nullptr)
-				{
-					conf_options = &default_options;
-				}
-				auto include_block (conf_options == nullptr ? true : conf_options->get_include_block ());
+				conf_options = &default_options;
+			}
+			auto include_block (conf_options->get_include_block ());
 
-				if (include_block && !msg_with_block)
-				{
-					msg_with_block = builder.block_confirmed (block_a, account_a, amount_a, subtype, include_block, election_status_a, *conf_options);
-				}
-				else if (!include_block && !msg_without_block)
-				{
-					msg_without_block = builder.block_confirmed (block_a, account_a, amount_a, subtype, include_block, election_status_a, *conf_options);
-				}
-				else
+			auto & msg (include_block ? msg_with_block : msg_without_block);
+			auto & buffer (include_block ? buffer_with_block : buffer_without_block);
+			if (!msg)
+			{
+				msg = builder.block_confirmed (block_a, account_a, amount_a, subtype, include_block, election_status_a, *conf_options);
+			}
+			auto filtered_l (subscription->second->should_filter (*msg));
+			lk.unlock ();
+
+			// Each variant is serialized once and the buffer shared by every session receiving it
+			if (!filtered_l)
+			{
+				if (!buffer)
 				{
-					assert (false);
+					buffer = msg->to_buffer ();
 				}
-
-				session_ptr->write (include_block ? msg_with_block.get () : msg_without_block.get ());
+				session_ptr->write (*buffer);
 			}
 		}
 	}
 }
 
-void nano::websocket::listener::broadcast (nano::websocket::message message_a)
+void nano::websocket::listener::broadcast (nano::websocket::message const & message_a)
 {
+	boost::optional<nano::shared_const_buffer> buffer;
 	nano::lock_guard<std::mutex> lk (sessions_mutex);
 	for (auto & weak_session : sessions)
 	{
 		auto session_ptr (weak_session.lock ());
-		if (session_ptr)
+		if (session_ptr && session_ptr->should_write (message_a))
 		{
-			session_ptr->write (message_a);
+			if (!buffer)
+			{
+				buffer = message_a.to_buffer ();
+			}
+			session_ptr->write (*buffer);
 		}
 	}
 }
@@ -812,3 +1044,8 @@ std::string nano::websocket::message::to_string () const
 	ostream.flush ();
 	return ostream.str ();
 }
+
+nano::shared_const_buffer nano::websocket::message::to_buffer () const
+{
+	return nano::shared_const_buffer (to_string ());
+}
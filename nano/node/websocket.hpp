@@ -2,8 +2,10 @@
 
 #include <nano/boost/beast/core.hpp>
 #include <nano/boost/beast/websocket.hpp>
+#include <nano/lib/asio.hpp>
 #include <nano/lib/blocks.hpp>
 #include <nano/lib/numbers.hpp>
+#include <nano/node/websocketconfig.hpp>
 
 #include <boost/property_tree/json_parser.hpp>
 
@@ -28,6 +30,7 @@ namespace nano
 {
 class wallets;
 class logger_mt;
+class stat;
 class vote;
 class election_status;
 enum class election_status_type : uint8_t;
@@ -35,6 +38,7 @@ namespace websocket
 {
 	class listener;
 	class confirmation_options;
+	class session;
 
 	/** Supported topics */
 	enum class topic
@@ -73,6 +77,8 @@ namespace websocket
 		}
 
 		std::string to_string () const;
+		/** Serializes the message into a buffer which can be shared by every session it is sent to */
+		nano::shared_const_buffer to_buffer () const;
 		nano::websocket::topic topic;
 		boost::property_tree::ptree contents;
 	};
@@ -120,6 +126,7 @@ namespace websocket
 	 * - "all_local_accounts" (bool) - will only not filter blocks that have local wallet accounts as source/destination
 	 * - "accounts" (array of std::strings) - will only not filter blocks that have these accounts as source/destination
 	 * @remark Both options can be given, the resulting filter is an intersection of individual filters
+	 * @remark The accounts can be changed with an "update" action, with the options "accounts_add" and "accounts_del" (arrays of std::strings)
 	 * @warn Legacy blocks are always filtered (not broadcasted)
 	 */
 	class confirmation_options final : public options
@@ -135,6 +142,23 @@ namespace websocket
 		 */
 		bool should_filter (message const & message_a) const override;
 
+		/**
+		 * Adds the accounts in "accounts_add" to and removes the accounts in "accounts_del" from the account filter.
+		 * The accounts which were actually added or removed are appended to \p added_a and \p removed_a
+		 */
+		void update (boost::property_tree::ptree const & options_a, nano::logger_mt & logger_a, std::vector<nano::account> & added_a, std::vector<nano::account> & removed_a);
+
+		/** Returns true if only blocks involving get_accounts () pass the account filter, so interested sessions can be found by account */
+		bool filters_by_account_list () const
+		{
+			return has_account_filtering_options && !all_local_accounts;
+		}
+
+		std::unordered_set<nano::account> const & get_accounts () const
+		{
+			return accounts;
+		}
+
 		/** Returns whether or not block contents should be included */
 		bool get_include_block () const
 		{
@@ -160,7 +184,10 @@ namespace websocket
 		bool has_account_filtering_options{ false };
 		bool all_local_accounts{ false };
 		uint8_t confirmation_types{ type_all };
-		std::unordered_set<std::string> accounts;
+		std::unordered_set<nano::account> accounts;
+
+		/** Decodes \p accounts_a, adding them to the account filter if \p insert_a is true and removing them otherwise. Changed accounts are appended to \p changed_a */
+		void update_accounts (boost::property_tree::ptree const & accounts_a, bool insert_a, nano::logger_mt & logger_a, std::vector<nano::account> & changed_a);
 	};
 
 	/**
@@ -187,6 +214,31 @@ namespace websocket
 		bool include_indeterminate{ false };
 	};
 
+	/**
+	 * Sessions subscribed to block confirmations. Sessions filtering on a list of accounts are indexed by those accounts,
+	 * so a confirmation only visits the sessions following its accounts, plus the sessions which must check every confirmation.
+	 */
+	class confirmation_index final
+	{
+	public:
+		/** Registers \p session_a. If \p accounts_a is null the session is offered every confirmation */
+		void insert (std::shared_ptr<nano::websocket::session> const & session_a, std::unordered_set<nano::account> const * accounts_a);
+		/** Removes a registration made with the same \p accounts_a, which must reflect any updates since */
+		void erase (nano::websocket::session const & session_a, std::unordered_set<nano::account> const * accounts_a);
+		/** Incrementally changes the accounts of an indexed session */
+		void update (nano::websocket::session const & session_a, std::vector<nano::account> const & added_a, std::vector<nano::account> const & removed_a);
+		/** Returns the live sessions which may be interested in a block involving any of \p accounts_a */
+		std::vector<std::shared_ptr<nano::websocket::session>> find (std::vector<nano::account> const & accounts_a);
+
+	private:
+		/** Requires mutex */
+		void erase_account (nano::websocket::session const & session_a, nano::account const & account_a);
+		std::mutex mutex;
+		std::unordered_map<nano::websocket::session const *, std::weak_ptr<nano::websocket::session>> sessions;
+		std::unordered_set<nano::websocket::session const *> unindexed;
+		std::unordered_map<nano::account, std::unordered_set<nano::websocket::session const *>> accounts;
+	};
+
 	/** A websocket session managing its own lifetime */
 	class session final : public std::enable_shared_from_this<session>
 	{
@@ -206,8 +258,14 @@ namespace websocket
 		/** Read the next message. This implicitely handles incoming websocket pings. */
 		void read ();
 
-		/** Enqueue \p message_a for writing to the websockets */
-		void write (nano::websocket::message message_a);
+		/** Enqueue \p message_a for writing to the websockets, if this session subscribes to it */
+		void write (nano::websocket::message const & message_a);
+
+		/** Enqueue an already serialized message for writing to the websockets, without checking subscriptions */
+		void write (nano::shared_const_buffer const & buffer_a);
+
+		/** Returns true if \p message_a is an acknowledgement, or this session subscribes to its topic and the subscription options do not filter it */
+		bool should_write (nano::websocket::message const & message_a);
 
 	private:
 		/** The owning listener */
@@ -218,8 +276,13 @@ namespace websocket
 		boost::beast::multi_buffer read_buffer;
 		/** All websocket operations that are thread unsafe must go through a strand. */
 		boost::asio::strand<boost::asio::io_context::executor_type> strand;
-		/** Outgoing messages. The send queue is protected by accessing it only through the strand */
-		std::deque<message> send_queue;
+		/**
+		 * Outgoing serialized messages, bounded by the listener configuration. The front message is being written.
+		 * The send queue is protected by accessing it only through the strand.
+		 */
+		std::deque<nano::shared_const_buffer> send_queue;
+		/** Set once the send queue overflowed under the disconnect policy. Only accessed through the strand. */
+		bool overflowed{ false };
 
 		/** Hash functor for topic enums */
 		struct topic_hash
@@ -236,6 +299,10 @@ namespace websocket
 
 		/** Handle incoming message */
 		void handle_message (boost::property_tree::ptree const & message_a);
+		/** Adds the confirmation subscription \p options_a to the listener index. Requires subscriptions_mutex */
+		void index_confirmation (nano::websocket::options const & options_a);
+		/** Removes the confirmation subscription \p options_a from the listener index. Requires subscriptions_mutex */
+		void unindex_confirmation (nano::websocket::options const & options_a);
 		/** Acknowledge incoming message */
 		void send_ack (std::string action_a, std::string id_a);
 		/** Send all queued messages. This must be called from the write strand. */
@@ -246,7 +313,7 @@ namespace websocket
 	class listener final : public std::enable_shared_from_this<listener>
 	{
 	public:
-		listener (nano::logger_mt & logger_a, nano::wallets & wallets_a, boost::asio::io_context & io_ctx_a, boost::asio::ip::tcp::endpoint endpoint_a);
+		listener (nano::websocket::config const & config_a, nano::logger_mt & logger_a, nano::wallets & wallets_a, nano::stat & stats_a, boost::asio::io_context & io_ctx_a, boost::asio::ip::tcp::endpoint endpoint_a);
 
 		/** Start accepting connections */
 		void run ();
@@ -256,11 +323,14 @@ namespace websocket
 		/** Close all websocket sessions and stop listening for new connections */
 		void stop ();
 
-		/** Broadcast block confirmation. The content of the message depends on subscription options (such as "include_block") */
+		/**
+		 * Broadcast block confirmation. The content of the message depends on subscription options (such as "include_block").
+		 * Only sessions indexed under the block account or link, or without an account list filter, are visited.
+		 */
 		void broadcast_confirmation (std::shared_ptr<nano::block> block_a, nano::account const & account_a, nano::amount const & amount_a, std::string subtype, nano::election_status const & election_status_a);
 
-		/** Broadcast \p message to all session subscribing to the message topic. */
-		void broadcast (nano::websocket::message message_a);
+		/** Broadcast \p message to all session subscribing to the message topic. The message is serialized at most once. */
+		void broadcast (nano::websocket::message const & message_a);
 
 		nano::logger_mt & get_logger () const
 		{
@@ -295,12 +365,15 @@ namespace websocket
 		/** Removes from subscription count of a specific topic*/
 		void decrease_subscriber_count (nano::websocket::topic const & topic_a);
 
+		nano::websocket::config const config;
 		nano::logger_mt & logger;
 		nano::wallets & wallets;
+		nano::stat & stats;
 		boost::asio::ip::tcp::acceptor acceptor;
 		socket_type socket;
 		std::mutex sessions_mutex;
 		std::vector<std::weak_ptr<session>> sessions;
+		nano::websocket::confirmation_index confirmation_sessions;
 		std::array<std::atomic<std::size_t>, number_topics> topic_subscriber_count{};
 		std::atomic<bool> stopped{ false };
 	};
@@ -9,11 +9,39 @@ address (boost::asio::ip::address_v6::loopback ().to_string ())
 {
 }
 
+namespace
+{
+std::string to_string (nano::websocket::overflow_policy policy_a)
+{
+	return policy_a == nano::websocket::overflow_policy::disconnect ? "disconnect" : "drop";
+}
+
+bool from_string (std::string const & policy_a, nano::websocket::overflow_policy & result_a)
+{
+	auto error (false);
+	if (policy_a == "drop")
+	{
+		result_a = nano::websocket::overflow_policy::drop;
+	}
+	else if (policy_a == "disconnect")
+	{
+		result_a = nano::websocket::overflow_policy::disconnect;
+	}
+	else
+	{
+		error = true;
+	}
+	return error;
+}
+}
+
 nano::error nano::websocket::config::serialize_toml (nano::tomlconfig & toml) const
 {
 	toml.put ("enable", enabled, "Enable or disable WebSocket server.\ntype:bool");
 	toml.put ("address", address, "WebSocket server bind address.\ntype:string,ip");
 	toml.put ("port", port, "WebSocket server listening port.\ntype:uint16");
+	toml.put ("send_queue_max", send_queue_max, "Maximum number of messages queued for a single WebSocket session. Consumers falling further behind are handled according to overflow_policy.\ntype:uint32");
+	toml.put ("overflow_policy", to_string (overflow_policy), "Action taken when a session send queue is full. \"drop\" discards new messages until the queue drains, \"disconnect\" closes the session.\ntype:string,{drop,disconnect}");
 	return toml.get_error ();
 }
 
@@ -24,6 +52,17 @@ nano::error nano::websocket::config::deserialize_toml (nano::tomlconfig & toml)
 	toml.get_optional<boost::asio::ip::address_v6> ("address", address_l, boost::asio::ip::address_v6::loopback ());
 	address = address_l.to_string ();
 	toml.get<uint16_t> ("port", port);
+	toml.get<uint32_t> ("send_queue_max", send_queue_max);
+	auto overflow_policy_l (to_string (overflow_policy));
+	toml.get<std::string> ("overflow_policy", overflow_policy_l);
+	if (from_string (overflow_policy_l, overflow_policy))
+	{
+		toml.get_error ().set ("overflow_policy must be either \"drop\" or \"disconnect\"");
+	}
+	if (send_queue_max == 0)
+	{
+		toml.get_error ().set ("send_queue_max must be greater than zero");
+	}
 	return toml.get_error ();
 }
 
@@ -32,6 +71,8 @@ nano::error nano::websocket::config::serialize_json (nano::jsonconfig & json) co
 	json.put ("enable", enabled);
 	json.put ("address", address);
 	json.put ("port", port);
+	json.put ("send_queue_max", send_queue_max);
+	json.put ("overflow_policy", to_string (overflow_policy));
 	return json.get_error ();
 }
 
@@ -42,5 +83,16 @@ nano::error nano::websocket::config::deserialize_json (nano::jsonconfig & json)
 	json.get_required<boost::asio::ip::address_v6> ("address", address_l, boost::asio::ip::address_v6::loopback ());
 	address = address_l.to_string ();
 	json.get<uint16_t> ("port", port);
+	json.get<uint32_t> ("send_queue_max", send_queue_max);
+	auto overflow_policy_l (to_string (overflow_policy));
+	json.get<std::string> ("overflow_policy", overflow_policy_l);
+	if (from_string (overflow_policy_l, overflow_policy))
+	{
+		json.get_error ().set ("overflow_policy must be either \"drop\" or \"disconnect\"");
+	}
+	if (send_queue_max == 0)
+	{
+		json.get_error ().set ("send_queue_max must be greater than zero");
+	}
 	return json.get_error ();
 }
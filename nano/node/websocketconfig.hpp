@@ -9,6 +9,15 @@ class jsonconfig;
 class tomlconfig;
 namespace websocket
 {
+	/** What a session does when a consumer falls behind and its send queue is full */
+	enum class overflow_policy
+	{
+		/** Discard new messages until the queue drains */
+		drop,
+		/** Close the session */
+		disconnect
+	};
+
 	/** websocket configuration */
 	class config final
 	{
@@ -22,6 +31,9 @@ namespace websocket
 		bool enabled{ false };
 		uint16_t port;
 		std::string address;
+		/** Maximum number of messages queued per session */
+		uint32_t send_queue_max{ 1024 };
+		nano::websocket::overflow_policy overflow_policy{ nano::websocket::overflow_policy::drop };
 	};
 }
 }
@@ -1,3 +1,4 @@
+#include <nano/lib/stats.hpp>
 #include <nano/lib/threading.hpp>
 #include <nano/secure/blockstore.hpp>
 
@@ -434,7 +435,90 @@ void nano::write_transaction::renew ()
 	impl->renew ();
 }
 
+nano::block_store::block_store (nano::stat * stats_a) :
+block_cache (stats_a)
+{
+}
+
 bool nano::write_transaction::contains (nano::tables table_a) const
 {
 	return impl->contains (table_a);
 }
+
+nano::block_cache::block_cache (nano::stat * stats_a, size_t max_a) :
+stats (stats_a),
+max (max_a)
+{
+}
+
+std::shared_ptr<nano::block> nano::block_cache::get (nano::block_hash const & hash_a, nano::block_sideband & sideband_a, uint8_t const * data_a, size_t size_a, size_t successor_offset_a)
+{
+	assert (successor_offset_a + sizeof (nano::block_hash) <= size_a);
+	std::shared_ptr<nano::block> result;
+	{
+		nano::lock_guard<std::mutex> lock (mutex);
+		auto existing (entries.get<tag_hash> ().find (hash_a));
+		auto successor_end (successor_offset_a + sizeof (nano::block_hash));
+		// The entry may have been filled by a transaction seeing another version of this block, such as before its work was upgraded
+		if (existing != entries.get<tag_hash> ().end () && existing->value.size () == size_a && std::equal (data_a, data_a + successor_offset_a, existing->value.begin ()) && std::equal (data_a + successor_end, data_a + size_a, existing->value.begin () + successor_end))
+		{
+			result = existing->block;
+			sideband_a = existing->sideband;
+			entries.get<tag_sequence> ().relocate (entries.get<tag_sequence> ().end (), entries.project<tag_sequence> (existing));
+		}
+	}
+	auto hit (result != nullptr);
+	++(hit ? hits : misses);
+	if (stats != nullptr)
+	{
+		stats->inc (nano::stat::type::block_cache, hit ? nano::stat::detail::cache_hit : nano::stat::detail::cache_miss);
+	}
+	return result;
+}
+
+void nano::block_cache::put (nano::block_hash const & hash_a, std::shared_ptr<nano::block> const & block_a, nano::block_sideband const & sideband_a, uint8_t const * data_a, size_t size_a, size_t successor_offset_a)
+{
+	assert (successor_offset_a + sizeof (nano::block_hash) <= size_a);
+	std::vector<uint8_t> value (data_a, data_a + size_a);
+	std::fill_n (value.begin () + successor_offset_a, sizeof (nano::block_hash), uint8_t{ 0 });
+	nano::lock_guard<std::mutex> lock (mutex);
+	auto inserted (entries.get<tag_sequence> ().push_back (entry{ hash_a, block_a, sideband_a, value }));
+	if (inserted.second)
+	{
+		if (entries.size () > max)
+		{
+			entries.get<tag_sequence> ().pop_front ();
+		}
+	}
+	else
+	{
+		entries.get<tag_sequence> ().replace (inserted.first, entry{ hash_a, block_a, sideband_a, std::move (value) });
+	}
+}
+
+void nano::block_cache::erase (nano::block_hash const & hash_a)
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	entries.get<tag_hash> ().erase (hash_a);
+}
+
+void nano::block_cache::clear ()
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	entries.clear ();
+}
+
+size_t nano::block_cache::size ()
+{
+	nano::lock_guard<std::mutex> lock (mutex);
+	return entries.size ();
+}
+
+std::unique_ptr<nano::container_info_component> nano::collect_container_info (block_cache & block_cache, const std::string & name)
+{
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "entries", block_cache.size (), sizeof (nano::block_cache::entry) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "hits", block_cache.hits, 0 }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "misses", block_cache.misses, 0 }));
+	return composite;
+}
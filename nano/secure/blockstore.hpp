@@ -10,8 +10,15 @@
 #include <nano/secure/versioning.hpp>
 
 #include <boost/endian/conversion.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+#include <boost/multi_index_container.hpp>
 #include <boost/polymorphic_cast.hpp>
 
+#include <atomic>
+#include <functional>
+#include <mutex>
 #include <stack>
 
 namespace nano
@@ -647,6 +654,56 @@ private:
 };
 
 class ledger_cache;
+class stat;
+
+/**
+ * Size bounded, least recently used cache of deserialized blocks and their sideband, keyed by hash.
+ * The successor in a cached sideband may be stale, callers must read it from the database.
+ * Entries keep the database value they were deserialized from and are only returned for the same value, so a
+ * transaction reading an older or newer version of a block than the one cached never sees the cached one.
+ */
+class block_cache final
+{
+public:
+	/** Hits and misses are also counted in \p stats_a if set */
+	explicit block_cache (nano::stat * stats_a = nullptr, size_t = 64 * 1024);
+	/** Returns nullptr if the block is not cached from this database value. The successor, which starts at \p successor_offset_a, is not compared */
+	std::shared_ptr<nano::block> get (nano::block_hash const &, nano::block_sideband &, uint8_t const * data_a, size_t size_a, size_t successor_offset_a);
+	void put (nano::block_hash const &, std::shared_ptr<nano::block> const &, nano::block_sideband const &, uint8_t const * data_a, size_t size_a, size_t successor_offset_a);
+	void erase (nano::block_hash const &);
+	void clear ();
+	size_t size ();
+	std::atomic<uint64_t> hits{ 0 };
+	std::atomic<uint64_t> misses{ 0 };
+	nano::stat * const stats;
+	size_t const max;
+
+private:
+	class entry final
+	{
+	public:
+		nano::block_hash hash;
+		std::shared_ptr<nano::block> block;
+		nano::block_sideband sideband;
+		/** Database value the block was deserialized from, with the successor zeroed */
+		std::vector<uint8_t> value;
+	};
+	// clang-format off
+	class tag_sequence {};
+	class tag_hash {};
+	boost::multi_index_container<entry,
+	boost::multi_index::indexed_by<
+		boost::multi_index::sequenced<boost::multi_index::tag<tag_sequence>>,
+		boost::multi_index::hashed_unique<boost::multi_index::tag<tag_hash>,
+			boost::multi_index::member<entry, nano::block_hash, &entry::hash>>>>
+	entries;
+	// clang-format on
+	std::mutex mutex;
+
+	friend std::unique_ptr<container_info_component> collect_container_info (block_cache &, const std::string &);
+};
+
+std::unique_ptr<container_info_component> collect_container_info (block_cache & block_cache, const std::string & name);
 
 /**
  * Manages block storage and iteration
@@ -654,6 +711,7 @@ class ledger_cache;
 class block_store
 {
 public:
+	explicit block_store (nano::stat * = nullptr);
 	virtual ~block_store () = default;
 	virtual void initialize (nano::write_transaction const &, nano::genesis const &, nano::ledger_cache &) = 0;
 	virtual void block_put (nano::write_transaction const &, nano::block_hash const &, nano::block const &, nano::block_sideband const &) = 0;
@@ -715,6 +773,8 @@ public:
 	// Populate vote with the next sequence number
 	virtual std::shared_ptr<nano::vote> vote_generate (nano::transaction const &, nano::account const &, nano::raw_key const &, std::shared_ptr<nano::block>) = 0;
 	virtual std::shared_ptr<nano::vote> vote_generate (nano::transaction const &, nano::account const &, nano::raw_key const &, std::vector<nano::block_hash>) = 0;
+	// Populate votes for several representatives at once, the signing tasks are handed to the executor which must run all of them before returning
+	virtual std::vector<std::shared_ptr<nano::vote>> vote_generate (nano::transaction const &, std::vector<std::pair<nano::account, nano::raw_key>> const &, std::vector<nano::block_hash> const &, std::function<void(std::vector<std::function<void()>> const &)> const &) = 0;
 	// Return either vote or the stored vote with a higher sequence number
 	virtual std::shared_ptr<nano::vote> vote_max (nano::transaction const &, std::shared_ptr<nano::vote>) = 0;
 	// Return latest vote for an account considering the vote cache
@@ -768,9 +828,12 @@ public:
 	virtual nano::read_transaction tx_begin_read () = 0;
 
 	virtual std::string vendor_get () const = 0;
+
+	/** Deserialized blocks recently returned by block_get, shared between transactions */
+	mutable nano::block_cache block_cache;
 };
 
-std::unique_ptr<nano::block_store> make_store (nano::logger_mt & logger, boost::filesystem::path const & path, bool open_read_only = false, bool add_db_postfix = false, nano::rocksdb_config const & rocksdb_config = nano::rocksdb_config{}, nano::txn_tracking_config const & txn_tracking_config_a = nano::txn_tracking_config{}, std::chrono::milliseconds block_processor_batch_max_time_a = std::chrono::milliseconds (5000), int lmdb_max_dbs = 128, size_t batch_size = 512, bool backup_before_upgrade = false, bool rocksdb_backend = false);
+std::unique_ptr<nano::block_store> make_store (nano::logger_mt & logger, boost::filesystem::path const & path, bool open_read_only = false, bool add_db_postfix = false, nano::rocksdb_config const & rocksdb_config = nano::rocksdb_config{}, nano::txn_tracking_config const & txn_tracking_config_a = nano::txn_tracking_config{}, std::chrono::milliseconds block_processor_batch_max_time_a = std::chrono::milliseconds (5000), int lmdb_max_dbs = 128, size_t batch_size = 512, bool backup_before_upgrade = false, bool rocksdb_backend = false, nano::stat * stats = nullptr);
 }
 
 namespace std
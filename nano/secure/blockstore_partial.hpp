@@ -21,6 +21,11 @@ public:
 
 	friend class nano::block_predecessor_set<Val, Derived_Store>;
 
+	explicit block_store_partial (nano::stat * stats_a) :
+	block_store (stats_a)
+	{
+	}
+
 	std::mutex cache_mutex;
 
 	/**
@@ -128,26 +133,52 @@ public:
 		std::shared_ptr<nano::block> result;
 		if (value.size () != 0)
 		{
-			nano::bufferstream stream (reinterpret_cast<uint8_t const *> (value.data ()), value.size ());
-			result = nano::deserialize_block (stream, type);
-			assert (result != nullptr);
-			if (sideband_a)
+			nano::block_sideband sideband;
+			auto data (reinterpret_cast<uint8_t const *> (value.data ()));
+			auto cacheable (full_sideband (transaction_a) || entry_has_sideband (value.size (), type));
+			// Only entries with a full sideband are cached, their successor starts the sideband
+			auto successor_offset (value.size () - nano::block_sideband::size (type));
+			if (cacheable)
+			{
+				result = block_cache.get (hash_a, sideband, data, value.size (), successor_offset);
+			}
+			if (result != nullptr)
+			{
+				// The successor is the only part of an entry changed in place, so it is always read from the database value
+				nano::bufferstream stream (data + successor_offset, sideband.successor.bytes.size ());
+				auto error (nano::try_read (stream, sideband.successor.bytes));
+				(void)error;
+				assert (!error);
+				if (sideband_a)
+				{
+					*sideband_a = sideband;
+				}
+			}
+			else
 			{
-				sideband_a->type = type;
-				if (full_sideband (transaction_a) || entry_has_sideband (value.size (), type))
+				nano::bufferstream stream (data, value.size ());
+				result = nano::deserialize_block (stream, type);
+				assert (result != nullptr);
+				sideband.type = type;
+				if (cacheable)
 				{
-					auto error (sideband_a->deserialize (stream));
+					auto error (sideband.deserialize (stream));
 					(void)error;
 					assert (!error);
+					block_cache.put (hash_a, result, sideband, data, value.size (), successor_offset);
 				}
-				else
+				else if (sideband_a)
+				{
+					// Reconstruct sideband data for block. These entries are not cached as they are only seen before upgrading.
+					sideband.account = block_account_computed (transaction_a, hash_a);
+					sideband.balance = block_balance_computed (transaction_a, hash_a);
+					sideband.successor = block_successor (transaction_a, hash_a);
+					sideband.height = 0;
+					sideband.timestamp = 0;
+				}
+				if (sideband_a)
 				{
-					// Reconstruct sideband data for block.
-					sideband_a->account = block_account_computed (transaction_a, hash_a);
-					sideband_a->balance = block_balance_computed (transaction_a, hash_a);
-					sideband_a->successor = block_successor (transaction_a, hash_a);
-					sideband_a->height = 0;
-					sideband_a->timestamp = 0;
+					*sideband_a = sideband;
 				}
 			}
 		}
@@ -307,6 +338,30 @@ public:
 		return result;
 	}
 
+	std::vector<std::shared_ptr<nano::vote>> vote_generate (nano::transaction const & transaction_a, std::vector<std::pair<nano::account, nano::raw_key>> const & representatives_a, std::vector<nano::block_hash> const & blocks_a, std::function<void(std::vector<std::function<void()>> const &)> const & execute_a) override
+	{
+		std::vector<std::shared_ptr<nano::vote>> result (representatives_a.size ());
+		std::vector<std::function<void()>> tasks;
+		tasks.reserve (representatives_a.size ());
+		// Sequence numbers are reserved and the cache updated under a single lock, as with single vote generation
+		nano::lock_guard<std::mutex> lock (cache_mutex);
+		for (size_t i (0); i < representatives_a.size (); ++i)
+		{
+			auto const & representative (representatives_a[i]);
+			auto current (vote_current (transaction_a, representative.first));
+			uint64_t sequence ((current ? current->sequence : 0) + 1);
+			tasks.push_back ([& vote = result[i], &representative, &blocks_a, sequence]() {
+				vote = std::make_shared<nano::vote> (representative.first, representative.second, sequence, blocks_a);
+			});
+		}
+		execute_a (tasks);
+		for (auto const & vote : result)
+		{
+			vote_cache_l1[vote->account] = vote;
+		}
+		return result;
+	}
+
 	std::shared_ptr<nano::vote> vote_max (nano::transaction const & transaction_a, std::shared_ptr<nano::vote> vote_a) override
 	{
 		nano::lock_guard<std::mutex> lock (cache_mutex);
@@ -386,6 +441,7 @@ public:
 
 		auto status = del (transaction_a, table, hash_a);
 		release_assert (success (status));
+		block_cache.erase (hash_a);
 	}
 
 	int version_get (nano::transaction const & transaction_a) const override
@@ -422,6 +478,7 @@ public:
 		nano::db_val<Val> value{ data.size (), (void *)data.data () };
 		auto status = put (transaction_a, database_a, hash_a, value);
 		release_assert (success (status));
+		block_cache.erase (hash_a);
 	}
 
 	void pending_put (nano::write_transaction const & transaction_a, nano::pending_key const & key_a, nano::pending_info const & pending_info_a) override
@@ -595,12 +595,57 @@ nano::block_hash nano::vote::full_hash () const
 	blake2b_state state;
 	blake2b_init (&state, sizeof (result.bytes));
 	blake2b_update (&state, hash ().bytes.data (), sizeof (hash ().bytes));
-	blake2b_update (&state, account.bytes.data (), sizeof (account.bytes.data ()));
-	blake2b_update (&state, signature.bytes.data (), sizeof (signature.bytes.data ()));
+	blake2b_update (&state, account.bytes.data (), sizeof (account.bytes));
+	blake2b_update (&state, signature.bytes.data (), sizeof (signature.bytes));
 	blake2b_final (&state, result.bytes.data (), sizeof (result.bytes));
 	return result;
 }
 
+bool nano::vote::serialized_full_hash (nano::block_type type_a, uint8_t const * data_a, size_t size_a, nano::block_hash & full_hash_a)
+{
+	// Serialized as account, signature, sequence then either block hashes or blocks
+	auto const preamble_size (sizeof (nano::account) + sizeof (nano::signature) + sizeof (uint64_t));
+	auto const is_hashes (type_a == nano::block_type::not_a_block);
+	auto const is_blocks (type_a == nano::block_type::send || type_a == nano::block_type::receive || type_a == nano::block_type::open || type_a == nano::block_type::change || type_a == nano::block_type::state);
+	auto const item_size (is_hashes ? sizeof (nano::block_hash) : is_blocks ? nano::block::size (type_a) : 0);
+	auto error (item_size == 0 || size_a <= preamble_size || (size_a - preamble_size) % item_size != 0);
+	if (!error)
+	{
+		auto const count ((size_a - preamble_size) / item_size);
+		nano::block_hash hash;
+		blake2b_state state;
+		blake2b_init (&state, sizeof (hash.bytes));
+		if (is_hashes || count > 1)
+		{
+			blake2b_update (&state, hash_prefix.data (), hash_prefix.size ());
+		}
+		for (size_t i (0); i < count; ++i)
+		{
+			auto item (data_a + preamble_size + i * item_size);
+			if (is_hashes)
+			{
+				blake2b_update (&state, item, item_size);
+			}
+			else
+			{
+				nano::block_hash block_hash;
+				nano::block_hash block_full_hash;
+				nano::serialized_block_hashes (type_a, item, block_hash, block_full_hash);
+				blake2b_update (&state, block_hash.bytes.data (), sizeof (block_hash.bytes));
+			}
+		}
+		// The sequence is serialized in native byte order
+		blake2b_update (&state, data_a + sizeof (nano::account) + sizeof (nano::signature), sizeof (uint64_t));
+		blake2b_final (&state, hash.bytes.data (), sizeof (hash.bytes));
+
+		blake2b_init (&state, sizeof (full_hash_a.bytes));
+		blake2b_update (&state, hash.bytes.data (), sizeof (hash.bytes));
+		blake2b_update (&state, data_a, sizeof (nano::account) + sizeof (nano::signature));
+		blake2b_final (&state, full_hash_a.bytes.data (), sizeof (full_hash_a.bytes));
+	}
+	return error;
+}
+
 void nano::vote::serialize (nano::stream & stream_a, nano::block_type type) const
 {
 	write (stream_a, account);
@@ -777,6 +822,18 @@ std::shared_ptr<nano::vote> nano::vote_uniquer::unique (std::shared_ptr<nano::vo
 	return result;
 }
 
+std::shared_ptr<nano::vote> nano::vote_uniquer::find (nano::block_hash const & full_hash_a)
+{
+	std::shared_ptr<nano::vote> result;
+	nano::lock_guard<std::mutex> lock (mutex);
+	auto existing (votes.find (full_hash_a));
+	if (existing != votes.end ())
+	{
+		result = existing->second.lock ();
+	}
+	return result;
+}
+
 size_t nano::vote_uniquer::size ()
 {
 	nano::lock_guard<std::mutex> lock (mutex);
@@ -249,6 +249,8 @@ public:
 	std::string hashes_string () const;
 	nano::block_hash hash () const;
 	nano::block_hash full_hash () const;
+	/** Computes full_hash () over a serialized vote of \p type blocks without deserializing it. Returns true if the bytes are not a well formed vote */
+	static bool serialized_full_hash (nano::block_type, uint8_t const *, size_t, nano::block_hash &);
 	bool operator== (nano::vote const &) const;
 	bool operator!= (nano::vote const &) const;
 	void serialize (nano::stream &, nano::block_type) const;
@@ -279,6 +281,8 @@ public:
 
 	vote_uniquer (nano::block_uniquer &);
 	std::shared_ptr<nano::vote> unique (std::shared_ptr<nano::vote>);
+	/** Returns the live vote with this full hash, or nullptr */
+	std::shared_ptr<nano::vote> find (nano::block_hash const &);
 	size_t size ();
 
 private:
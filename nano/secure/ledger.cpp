@@ -3,8 +3,15 @@
 #include <nano/lib/utility.hpp>
 #include <nano/lib/work.hpp>
 #include <nano/secure/blockstore.hpp>
+#include <nano/secure/buffer.hpp>
 #include <nano/secure/ledger.hpp>
 
+#include <crypto/blake2/blake2.h>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <fstream>
+
 namespace
 {
 /**
@@ -683,7 +690,7 @@ verification (verification_a)
 }
 } // namespace
 
-nano::ledger::ledger (nano::block_store & store_a, nano::stat & stat_a, nano::generate_cache const & generate_cache_a) :
+nano::ledger::ledger (nano::block_store & store_a, nano::stat & stat_a, nano::generate_cache const & generate_cache_a, boost::filesystem::path const & cache_snapshot_path_a) :
 store (store_a),
 stats (stat_a),
 check_bootstrap_weights (true)
@@ -691,7 +698,8 @@ check_bootstrap_weights (true)
 	if (!store.init_error ())
 	{
 		auto transaction = store.tx_begin_read ();
-		if (generate_cache_a.reps)
+		auto snapshot_loaded (!cache_snapshot_path_a.empty () && !cache_snapshot_read (transaction, cache_snapshot_path_a));
+		if (!snapshot_loaded && generate_cache_a.reps)
 		{
 			for (auto i (store.latest_begin (transaction)), n (store.latest_end ()); i != n; ++i)
 			{
@@ -700,7 +708,7 @@ check_bootstrap_weights (true)
 			}
 		}
 
-		if (generate_cache_a.cemented_count)
+		if (!snapshot_loaded && generate_cache_a.cemented_count)
 		{
 			for (auto i (store.confirmation_height_begin (transaction)), n (store.confirmation_height_end ()); i != n; ++i)
 			{
@@ -708,7 +716,7 @@ check_bootstrap_weights (true)
 			}
 		}
 
-		if (generate_cache_a.unchecked_count)
+		if (!snapshot_loaded && generate_cache_a.unchecked_count)
 		{
 			cache.unchecked_count = store.unchecked_count (transaction);
 		}
@@ -717,6 +725,131 @@ check_bootstrap_weights (true)
 	}
 }
 
+uint8_t constexpr nano::ledger::cache_snapshot_version;
+
+/*
+ * Snapshot layout: header | cemented count | unchecked count | representative count | (representative, weight)* | blake2b checksum
+ * The header identifies the store state the snapshot was taken from, a snapshot is only loaded if it matches exactly.
+ */
+std::vector<uint8_t> nano::ledger::cache_snapshot_header (nano::transaction const & transaction_a)
+{
+	std::vector<uint8_t> result;
+	{
+		nano::vectorstream stream (result);
+		nano::write (stream, std::array<char, 8>{ { 'n', 'a', 'n', 'o', 'l', 'c', 's', 'n' } });
+		nano::write (stream, cache_snapshot_version);
+		nano::write (stream, static_cast<int32_t> (store.version_get (transaction_a)));
+		nano::write (stream, nano::genesis ().hash ());
+		nano::write (stream, static_cast<uint64_t> (store.block_count (transaction_a).sum ()));
+		nano::write (stream, static_cast<uint64_t> (store.account_count (transaction_a)));
+		nano::write (stream, store.confirmation_height_count (transaction_a));
+	}
+	return result;
+}
+
+bool nano::ledger::cache_snapshot_write (boost::filesystem::path const & path_a)
+{
+	std::vector<uint8_t> snapshot;
+	{
+		auto transaction (store.tx_begin_read ());
+		snapshot = cache_snapshot_header (transaction);
+	}
+	{
+		nano::vectorstream stream (snapshot);
+		nano::write (stream, cache.cemented_count.load ());
+		nano::write (stream, cache.unchecked_count.load ());
+		auto rep_amounts (cache.rep_weights.get_rep_amounts ());
+		nano::write (stream, static_cast<uint64_t> (rep_amounts.size ()));
+		for (auto const & rep_amount : rep_amounts)
+		{
+			nano::write (stream, rep_amount.first);
+			nano::write (stream, nano::amount (rep_amount.second));
+		}
+	}
+	nano::uint256_union checksum;
+	blake2b_state hash;
+	blake2b_init (&hash, sizeof (checksum.bytes));
+	blake2b_update (&hash, snapshot.data (), snapshot.size ());
+	blake2b_final (&hash, checksum.bytes.data (), sizeof (checksum.bytes));
+	snapshot.insert (snapshot.end (), checksum.bytes.begin (), checksum.bytes.end ());
+
+	// Write to a temporary file first so a crash never leaves a truncated snapshot behind
+	auto temp_path (path_a);
+	temp_path += ".tmp";
+	auto error (false);
+	{
+		std::ofstream file (temp_path.string (), std::ios::binary | std::ios::trunc);
+		file.write (reinterpret_cast<char const *> (snapshot.data ()), snapshot.size ());
+		file.close ();
+		error = file.fail ();
+	}
+	boost::system::error_code ec;
+	if (!error)
+	{
+		boost::filesystem::rename (temp_path, path_a, ec);
+		error = static_cast<bool> (ec);
+	}
+	if (error)
+	{
+		boost::filesystem::remove (temp_path, ec);
+	}
+	return error;
+}
+
+bool nano::ledger::cache_snapshot_read (nano::transaction const & transaction_a, boost::filesystem::path const & path_a)
+{
+	std::vector<uint8_t> snapshot;
+	{
+		std::ifstream file (path_a.string (), std::ios::binary);
+		if (file.is_open ())
+		{
+			snapshot.assign (std::istreambuf_iterator<char> (file), std::istreambuf_iterator<char> ());
+		}
+	}
+	// The snapshot is consumed whether or not it is valid, the store is about to be written to which would make it stale
+	boost::system::error_code ec;
+	boost::filesystem::remove (path_a, ec);
+
+	auto header (cache_snapshot_header (transaction_a));
+	nano::uint256_union checksum;
+	auto error (snapshot.size () < header.size () + sizeof (checksum.bytes) || !std::equal (header.begin (), header.end (), snapshot.begin ()));
+	if (!error)
+	{
+		auto payload_size (snapshot.size () - sizeof (checksum.bytes));
+		blake2b_state hash;
+		blake2b_init (&hash, sizeof (checksum.bytes));
+		blake2b_update (&hash, snapshot.data (), payload_size);
+		blake2b_final (&hash, checksum.bytes.data (), sizeof (checksum.bytes));
+		error = !std::equal (checksum.bytes.begin (), checksum.bytes.end (), snapshot.begin () + payload_size);
+		if (!error)
+		{
+			nano::bufferstream stream (snapshot.data () + header.size (), payload_size - header.size ());
+			uint64_t cemented_count;
+			uint64_t unchecked_count;
+			uint64_t rep_count;
+			error = nano::try_read (stream, cemented_count) || nano::try_read (stream, unchecked_count) || nano::try_read (stream, rep_count);
+			std::vector<std::pair<nano::account, nano::amount>> rep_amounts;
+			for (uint64_t i (0); !error && i < rep_count; ++i)
+			{
+				nano::account representative;
+				nano::amount weight;
+				error = nano::try_read (stream, representative) || nano::try_read (stream, weight);
+				rep_amounts.emplace_back (representative, weight);
+			}
+			if (!error)
+			{
+				for (auto const & rep_amount : rep_amounts)
+				{
+					cache.rep_weights.representation_put (rep_amount.first, rep_amount.second);
+				}
+				cache.cemented_count = cemented_count;
+				cache.unchecked_count = unchecked_count;
+			}
+		}
+	}
+	return error;
+}
+
 // Balance for account containing hash
 nano::uint128_t nano::ledger::balance (nano::transaction const & transaction_a, nano::block_hash const & hash_a) const
 {
@@ -1142,5 +1275,6 @@ std::unique_ptr<nano::container_info_component> nano::collect_container_info (le
 	auto composite = std::make_unique<container_info_composite> (name);
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "bootstrap_weights", count, sizeof_element }));
 	composite->add_component (collect_container_info (ledger.cache.rep_weights, "rep_weights"));
+	composite->add_component (collect_container_info (ledger.store.block_cache, "block_cache"));
 	return composite;
 }
@@ -3,6 +3,8 @@
 #include <nano/lib/rep_weights.hpp>
 #include <nano/secure/common.hpp>
 
+#include <boost/filesystem/path.hpp>
+
 #include <map>
 
 namespace nano
@@ -15,7 +17,8 @@ using tally_t = std::map<nano::uint128_t, std::shared_ptr<nano::block>, std::gre
 class ledger final
 {
 public:
-	ledger (nano::block_store &, nano::stat &, nano::generate_cache const & = nano::generate_cache ());
+	/** If \p cache_snapshot_path_a names a valid snapshot it is consumed instead of scanning the store to generate the cache */
+	ledger (nano::block_store &, nano::stat &, nano::generate_cache const & = nano::generate_cache (), boost::filesystem::path const & cache_snapshot_path_a = boost::filesystem::path ());
 	nano::account account (nano::transaction const &, nano::block_hash const &) const;
 	nano::uint128_t amount (nano::transaction const &, nano::account const &);
 	nano::uint128_t amount (nano::transaction const &, nano::block_hash const &);
@@ -47,7 +50,10 @@ public:
 	bool is_epoch_link (nano::link const &);
 	nano::account const & epoch_signer (nano::link const &) const;
 	nano::link const & epoch_link (nano::epoch) const;
+	/** Saves the ledger cache so the next startup can skip generating it. Only valid once all ledger writers are stopped. Returns true on error */
+	bool cache_snapshot_write (boost::filesystem::path const &);
 	static nano::uint128_t const unit;
+	static uint8_t constexpr cache_snapshot_version = 1;
 	nano::network_params network_params;
 	nano::block_store & store;
 	nano::ledger_cache cache;
@@ -56,6 +62,10 @@ public:
 	std::atomic<size_t> bootstrap_weights_size{ 0 };
 	uint64_t bootstrap_weight_max_blocks{ 1 };
 	std::atomic<bool> check_bootstrap_weights;
+
+private:
+	bool cache_snapshot_read (nano::transaction const &, boost::filesystem::path const &);
+	std::vector<uint8_t> cache_snapshot_header (nano::transaction const &);
 };
 
 std::unique_ptr<container_info_component> collect_container_info (ledger & ledger, const std::string & name);
@@ -0,0 +1,70 @@
+#include <nano/crypto_lib/random_pool.hpp>
+#include <nano/lib/blocks.hpp>
+#include <nano/secure/buffer.hpp>
+#include <nano/secure/network_filter.hpp>
+
+#include <crypto/blake2/blake2.h>
+
+nano::network_filter::digest_t constexpr nano::network_filter::empty;
+
+nano::network_filter::network_filter (size_t size_a) :
+slots (size_a)
+{
+	assert (size_a > 0);
+	for (auto & slot : slots)
+	{
+		slot.store (empty);
+	}
+	nano::random_pool::generate_block (key.bytes.data (), key.bytes.size ());
+}
+
+bool nano::network_filter::apply (uint8_t const * bytes_a, size_t count_a, digest_t * digest_a)
+{
+	auto digest (hash (bytes_a, count_a));
+	if (digest_a != nullptr)
+	{
+		*digest_a = digest;
+	}
+	auto previous (slot (digest).exchange (digest, std::memory_order_relaxed));
+	return previous == digest;
+}
+
+void nano::network_filter::clear (digest_t const & digest_a)
+{
+	// Only reset the slot if it still holds this digest, another item may have taken it since
+	auto expected (digest_a);
+	slot (digest_a).compare_exchange_strong (expected, empty, std::memory_order_relaxed);
+}
+
+void nano::network_filter::clear (nano::block const & block_a)
+{
+	std::vector<uint8_t> bytes;
+	{
+		nano::vectorstream stream (bytes);
+		block_a.serialize (stream);
+	}
+	clear (hash (bytes.data (), bytes.size ()));
+}
+
+void nano::network_filter::clear ()
+{
+	for (auto & slot : slots)
+	{
+		slot.store (empty, std::memory_order_relaxed);
+	}
+}
+
+nano::network_filter::digest_t nano::network_filter::hash (uint8_t const * bytes_a, size_t count_a) const
+{
+	digest_t result;
+	blake2b_state state;
+	blake2b_init_key (&state, sizeof (result), key.bytes.data (), key.bytes.size ());
+	blake2b_update (&state, bytes_a, count_a);
+	blake2b_final (&state, &result, sizeof (result));
+	return result != empty ? result : empty + 1;
+}
+
+std::atomic<nano::network_filter::digest_t> & nano::network_filter::slot (digest_t const & digest_a)
+{
+	return slots[digest_a % slots.size ()];
+}
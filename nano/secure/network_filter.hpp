@@ -0,0 +1,38 @@
+#pragma once
+
+#include <nano/lib/numbers.hpp>
+
+#include <atomic>
+#include <vector>
+
+namespace nano
+{
+class block;
+/**
+ * A fixed size, lock-free set of recently seen message digests used to drop duplicates before they are deserialized.
+ * Digests are keyed with a random per-instance key so peers cannot target slots, each digest has exactly one slot and a
+ * newer digest evicts whichever digest previously occupied it, so false negatives are possible but false positives need a 64-bit collision.
+ */
+class network_filter final
+{
+public:
+	using digest_t = uint64_t;
+	explicit network_filter (size_t size_a);
+	/** Records the digest of \p bytes_a, returns true if it was already present. The digest is written to \p digest_a if not null */
+	bool apply (uint8_t const * bytes_a, size_t count_a, digest_t * digest_a = nullptr);
+	/** Forgets \p digest_a so the same item is accepted again */
+	void clear (digest_t const & digest_a);
+	/** Forgets the digest of \p block_a, as received in a publish message */
+	void clear (nano::block const & block_a);
+	/** Forgets all digests */
+	void clear ();
+	digest_t hash (uint8_t const * bytes_a, size_t count_a) const;
+
+private:
+	std::atomic<digest_t> & slot (digest_t const & digest_a);
+	std::vector<std::atomic<digest_t>> slots;
+	nano::uint128_union key;
+	/** Marks an empty slot, digests which hash to it are remapped */
+	static digest_t constexpr empty{ 0 };
+};
+}
@@ -664,6 +664,84 @@ TEST (confirmation_height, long_chains)
 	ASSERT_EQ (node->ledger.stats.count (nano::stat::type::confirmation_height, nano::stat::detail::blocks_confirmed, nano::stat::dir::in), num_blocks * 2 + 2);
 }
 
+// Cementing a very long chain is done in bounded ranges, with observers notified as each range is written and nothing kept per cemented block
+TEST (confirmation_height, very_long_chain)
+{
+	nano::system system;
+	nano::node_config node_config (nano::get_available_port (), system.logging);
+	node_config.frontiers_confirmation = nano::frontiers_confirmation_mode::disabled;
+	auto node = system.add_node (node_config);
+	nano::keypair key1;
+	system.wallet (0)->insert_adhoc (nano::test_genesis_key.prv);
+	nano::block_hash latest (node->latest (nano::test_genesis_key.pub));
+
+	constexpr uint64_t num_blocks = 5000000;
+	// Send to a non-existing account so that the whole chain is on the genesis account
+	for (uint64_t i = 0; i < num_blocks;)
+	{
+		auto transaction = node->store.tx_begin_write ();
+		for (auto end = std::min (num_blocks, i + 100000); i < end; ++i)
+		{
+			nano::state_block send (nano::test_genesis_key.pub, latest, nano::test_genesis_key.pub, nano::genesis_amount - i - 1, key1.pub, nano::test_genesis_key.prv, nano::test_genesis_key.pub, *system.work.generate (latest));
+			ASSERT_EQ (nano::process_result::progress, node->ledger.process (transaction, send).code);
+			latest = send.hash ();
+		}
+	}
+
+	std::atomic<uint64_t> notified{ 0 };
+	node->observers.blocks.add ([&notified](nano::election_status const &, nano::account const &, nano::amount const &, bool) {
+		++notified;
+	});
+
+	auto last (node->store.block_get (node->store.tx_begin_read (), latest));
+	node->block_confirm (last);
+
+	// Each write transaction cements at most batch_cement_size blocks, so the confirmation height is seen rising in steps
+	std::unordered_set<uint64_t> heights_seen;
+	uint64_t pending_writes_peak (0);
+	uint64_t election_callbacks_peak (0);
+	uint64_t receive_source_pairs_peak (0);
+	auto & processor (node->confirmation_height_processor);
+	uint64_t const batch_write_size (nano::confirmation_height_processor::batch_write_size);
+	uint64_t const batch_cement_size (nano::confirmation_height_processor::batch_cement_size);
+	system.deadline_set (3600s);
+	while (true)
+	{
+		// The memory held by the processor must not depend on the length of the chain
+		pending_writes_peak = std::max<uint64_t> (pending_writes_peak, processor.pending_writes_size);
+		election_callbacks_peak = std::max<uint64_t> (election_callbacks_peak, processor.election_callbacks_size);
+		receive_source_pairs_peak = std::max<uint64_t> (receive_source_pairs_peak, processor.receive_source_pairs_size);
+		ASSERT_LE (pending_writes_peak, batch_write_size);
+		ASSERT_LE (election_callbacks_peak, batch_cement_size);
+		ASSERT_LE (receive_source_pairs_peak, batch_cement_size);
+		nano::confirmation_height_info confirmation_height_info;
+		ASSERT_FALSE (node->store.confirmation_height_get (node->store.tx_begin_read (), nano::test_genesis_key.pub, confirmation_height_info));
+		heights_seen.insert (confirmation_height_info.height);
+		if (confirmation_height_info.height == num_blocks + 1)
+		{
+			break;
+		}
+		ASSERT_LE (confirmation_height_info.height, num_blocks + 1);
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	ASSERT_GT (heights_seen.size (), 2);
+	for (auto height : heights_seen)
+	{
+		ASSERT_TRUE (height == num_blocks + 1 || (height - 1) % nano::confirmation_height_processor::batch_cement_size == 0);
+	}
+	ASSERT_EQ (num_blocks, node->ledger.stats.count (nano::stat::type::confirmation_height, nano::stat::detail::blocks_confirmed, nano::stat::dir::in));
+	ASSERT_EQ (num_blocks + 1, node->ledger.cache.cemented_count);
+	system.deadline_set (60s);
+	while (notified < num_blocks)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	// There are no receives in the chain, and nothing is left behind once cementing has finished
+	ASSERT_EQ (0, receive_source_pairs_peak);
+	ASSERT_EQ (0, processor.pending_writes_size);
+	ASSERT_EQ (0, processor.election_callbacks_size);
+}
+
 // Can take up to 1 hour
 TEST (confirmation_height, prioritize_frontiers_overwrite)
 {